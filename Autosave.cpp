@@ -0,0 +1,197 @@
+#include "Autosave.hpp"
+#include "BinaryScene.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+Autosave::Autosave(const std::string& directory, sf::Time interval)
+    : directory(directory), interval(interval) {
+}
+
+Autosave::~Autosave() {
+    finishSave(true);
+}
+
+std::string Autosave::chunkFileName(const ChunkCoord& coord) {
+    return "chunk_" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + ".escb";
+}
+
+std::string Autosave::manifestPath() const {
+    return (fs::path(directory) / "manifest").string();
+}
+
+void Autosave::update(ChunkedScene& scene, const EntityManager& entityManager) {
+    finishSave(false);
+    if (isSaving() || sinceLastSave.getElapsedTime() < interval) {
+        return;
+    }
+
+    sinceLastSave.restart();
+    if (scene.getEditStamp() == savedEdit) {
+        return;
+    }
+
+    // Só ponteiros compartilhados: edições feitas a partir daqui copiam o chunk
+    // antes de alterá-lo, e a thread de gravação continua vendo este estado
+    updatePrototypeNames(entityManager);
+    scene.takeSnapshot(savedEdit, snapshot);
+    pendingEdit = scene.getEditStamp();
+
+    // A thread de gravação recebe só um ponteiro cru: a última referência aos
+    // snapshots é solta aqui, na thread principal, depois de pendingSave.get().
+    // Assim use_count() == 1 em InstanceStore::mutableData() garante que a
+    // gravação já terminou de ler os dados antes de serem alterados no lugar
+    pendingJob = std::make_shared<SaveJob>();
+    pendingJob->directory = directory;
+    pendingJob->chunks.swap(snapshot);
+    pendingJob->prototypeNames = prototypeNames;
+    const SaveJob* job = pendingJob.get();
+    pendingSave = std::async(std::launch::async, [job]() { return write(*job); });
+}
+
+sf::Time Autosave::getTimeUntilDue() const {
+    sf::Time elapsed = sinceLastSave.getElapsedTime();
+    return elapsed < interval ? interval - elapsed : sf::Time::Zero;
+}
+
+void Autosave::finishSave(bool wait) {
+    if (!pendingSave.valid()) {
+        return;
+    }
+    if (!wait && pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+
+    bool saved = pendingSave.get();
+    // Devolve o vetor para reaproveitar a capacidade; os snapshots são soltos aqui
+    snapshot.swap(pendingJob->chunks);
+    snapshot.clear();
+    pendingJob.reset();
+    if (saved) {
+        savedEdit = pendingEdit;
+    } else {
+        // savedEdit não avança: a próxima gravação inclui de novo estes chunks
+        LOG_ERROR("Falha na gravação automática em " << directory);
+    }
+}
+
+void Autosave::updatePrototypeNames(const EntityManager& entityManager) {
+    const auto& entities = entityManager.getEntities();
+    if (prototypeNames && prototypeNames->size() == entities.size()) {
+        return;
+    }
+
+    // As chaves do EntityManager, não Entity::getName (que inclui o diretório carregado)
+    auto names = std::make_shared<std::vector<std::string>>();
+    names->reserve(entities.size());
+    for (std::size_t id = 0; id < entities.size(); ++id) {
+        names->push_back(*entityManager.getEntityPath(static_cast<PrototypeId>(id)));
+    }
+    prototypeNames = std::move(names);
+}
+
+bool Autosave::write(const SaveJob& job) {
+    PROFILE_SCOPE("autosaveWrite");
+    std::error_code ec;
+    fs::create_directories(job.directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Cada chunk vai para um temporário e é renomeado, para que o manifesto
+    // anterior continue apontando para arquivos completos até ser substituído
+    for (const ChunkSnapshot& chunk : job.chunks) {
+        if (!chunk.data) continue;
+
+        fs::path path = fs::path(job.directory) / chunkFileName(chunk.coord);
+        std::string tempPath = path.string() + ".tmp";
+        std::vector<ChunkSnapshot> single{chunk};
+        if (!BinaryScene::save(tempPath, single, *job.prototypeNames)) {
+            return false;
+        }
+        fs::rename(tempPath, path, ec);
+        if (ec) {
+            return false;
+        }
+    }
+
+    fs::path manifest = fs::path(job.directory) / "manifest";
+    std::string tempManifest = manifest.string() + ".tmp";
+    {
+        std::ofstream out(tempManifest, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        for (const ChunkSnapshot& chunk : job.chunks) {
+            out << chunkFileName(chunk.coord) << '\n';
+        }
+        out.close();
+        if (out.fail()) {
+            return false;
+        }
+    }
+    fs::rename(tempManifest, manifest, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Chunks que deixaram de existir na cena
+    std::set<std::string> current;
+    for (const ChunkSnapshot& chunk : job.chunks) {
+        current.insert(chunkFileName(chunk.coord));
+    }
+    for (const auto& entry : fs::directory_iterator(job.directory, ec)) {
+        std::string name = entry.path().filename().string();
+        if (entry.path().extension() == ".escb" && !current.count(name)) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+    return true;
+}
+
+bool Autosave::hasRecoveryData() const {
+    std::error_code ec;
+    return fs::exists(manifestPath(), ec);
+}
+
+bool Autosave::restore(ChunkedScene& scene, const EntityManager& entityManager) {
+    finishSave(true);
+
+    std::ifstream in(manifestPath());
+    if (!in) {
+        return false;
+    }
+
+    scene.clear();
+    std::string name;
+    std::size_t failed = 0;
+    while (std::getline(in, name)) {
+        if (name.empty()) continue;
+        if (!BinaryScene::load((fs::path(directory) / name).string(), scene, entityManager, false)) {
+            ++failed;
+        }
+    }
+
+    if (failed > 0) {
+        LOG_WARNING(failed << " chunk(s) da gravação automática não puderam ser lidos.");
+    }
+    LOG_INFO("Cena recuperada da gravação automática: " << scene.size() << " instâncias.");
+
+    // O conteúdo restaurado já está em disco; não há o que regravar
+    scene.takeSnapshot(scene.getEditStamp(), snapshot);
+    snapshot.clear();
+    savedEdit = scene.getEditStamp();
+    sinceLastSave.restart();
+    return failed == 0;
+}
+
+void Autosave::discard() {
+    finishSave(true);
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    savedEdit = 0;
+}
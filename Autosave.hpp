@@ -0,0 +1,61 @@
+#pragma once
+#include "ChunkedScene.hpp"
+#include "EntityManager.hpp"
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Gravação automática e incremental da cena em segundo plano.
+// Na thread principal só é tirado um snapshot copy-on-write dos chunks
+// (ChunkedScene::takeSnapshot); a serialização roda em outra thread e
+// reescreve apenas os chunks alterados desde a gravação anterior, cada um no
+// seu .escb. Um manifesto lista os chunks que compõem a cena.
+class Autosave {
+public:
+    Autosave(const std::string& directory, sf::Time interval);
+    ~Autosave();
+
+    Autosave(const Autosave&) = delete;
+    Autosave& operator=(const Autosave&) = delete;
+
+    // Chamar a cada quadro; inicia uma gravação quando o intervalo passou e a cena mudou
+    void update(ChunkedScene& scene, const EntityManager& entityManager);
+    bool isSaving() const { return pendingSave.valid(); }
+    // Há alterações ainda não gravadas em disco
+    bool hasUnsavedEdits(const ChunkedScene& scene) const { return scene.getEditStamp() != savedEdit; }
+    // Quanto falta para update() poder iniciar a próxima gravação
+    sf::Time getTimeUntilDue() const;
+
+    // Restos de uma sessão que não terminou normalmente
+    bool hasRecoveryData() const;
+    bool restore(ChunkedScene& scene, const EntityManager& entityManager);
+    // Apaga a gravação automática (saída normal do editor)
+    void discard();
+
+private:
+    struct SaveJob {
+        std::string directory;
+        std::vector<ChunkSnapshot> chunks;
+        std::shared_ptr<const std::vector<std::string>> prototypeNames;
+    };
+
+    static bool write(const SaveJob& job);
+    static std::string chunkFileName(const ChunkCoord& coord);
+    std::string manifestPath() const;
+    void finishSave(bool wait);
+    void updatePrototypeNames(const EntityManager& entityManager);
+
+    std::string directory;
+    sf::Time interval;
+    sf::Clock sinceLastSave;
+
+    std::uint64_t savedEdit = 0;    // Marca de edição já gravada em disco
+    std::uint64_t pendingEdit = 0;  // Marca da gravação em andamento
+    std::future<bool> pendingSave;
+    std::shared_ptr<SaveJob> pendingJob;  // Solto só em finishSave, na thread principal
+    std::vector<ChunkSnapshot> snapshot;  // Reaproveitado entre gravações
+    std::shared_ptr<const std::vector<std::string>> prototypeNames;  // Nome de cada PrototypeId
+};
@@ -0,0 +1,278 @@
+#include "BatchTool.hpp"
+#include "BinaryScene.hpp"
+#include "ChunkedScene.hpp"
+#include "Entity.hpp"
+#include "EntityManager.hpp"
+#include "Log.hpp"
+#include "SceneExporter.hpp"
+#include "SceneImporter.hpp"
+#include "ThreadPool.hpp"
+#include <SFML/System.hpp>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Resultado de uma tarefa; impresso na thread principal, na ordem dos arquivos
+struct TaskReport {
+    bool ok = true;
+    std::string text;
+};
+
+std::string formatMilliseconds(sf::Time time) {
+    std::ostringstream out;
+    out << time.asMicroseconds() / 1000.0 << " ms";
+    return out.str();
+}
+
+int printReports(std::vector<std::future<TaskReport>>& reports, sf::Clock& total, const char* what) {
+    std::size_t failed = 0;
+    for (auto& report : reports) {
+        TaskReport result = report.get();
+        // Mensagens de log da tarefa saem antes do relatório dela
+        Log::flush();
+        std::cout << result.text;
+        if (!result.ok) ++failed;
+    }
+
+    std::cout << reports.size() << " " << what << ", " << failed << " com erro, "
+              << formatMilliseconds(total.getElapsedTime()) << " no total" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+}
+
+int BatchTool::run(const std::vector<std::string>& args) {
+    Options options;
+    if (!parseOptions(args, options)) {
+        printUsage();
+        return 2;
+    }
+
+    if (options.command == "convert") {
+        return convert(options);
+    }
+    if (options.command == "bench") {
+        Benchmark benchmark(options.bench);
+        return benchmark.run() ? 0 : 1;
+    }
+    return validate(options);
+}
+
+bool BatchTool::parseOptions(const std::vector<std::string>& args, Options& options) {
+    if (args.empty()) return false;
+    options.command = args[0];
+    if (options.command != "convert" && options.command != "validate" && options.command != "bench") {
+        std::cerr << "Comando desconhecido: " << options.command << std::endl;
+        return false;
+    }
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+        if (arg == "--entities" && hasValue) {
+            options.entitiesDirectory = args[++i];
+        } else if (arg == "--to" && hasValue) {
+            options.targetFormat = args[++i];
+        } else if (arg == "--out" && hasValue) {
+            options.bench.outputPath = args[++i];
+        } else if (arg == "--work" && hasValue) {
+            options.bench.workDirectory = args[++i];
+        } else if ((arg == "--jobs" || arg == "--library-size" || arg == "--seed" || arg == "--frames" ||
+                    arg == "--sizes") && hasValue) {
+            try {
+                const std::string& value = args[++i];
+                if (arg == "--jobs") {
+                    options.jobs = std::stoul(value);
+                } else if (arg == "--library-size") {
+                    options.bench.librarySize = std::stoul(value);
+                } else if (arg == "--seed") {
+                    options.bench.seed = static_cast<std::uint32_t>(std::stoul(value));
+                } else if (arg == "--frames") {
+                    options.bench.renderFrames = std::stoi(value);
+                } else {
+                    options.bench.sceneSizes.clear();
+                    std::istringstream sizes(value);
+                    for (std::string size; std::getline(sizes, size, ',');) {
+                        options.bench.sceneSizes.push_back(std::stoul(size));
+                    }
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Valor inválido para " << arg << ": " << args[i] << std::endl;
+                return false;
+            }
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::cerr << "Opção desconhecida ou sem valor: " << arg << std::endl;
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+
+    if (options.command == "bench") {
+        return true;
+    }
+    if (options.inputs.empty()) {
+        std::cerr << "Nenhum arquivo de entrada" << std::endl;
+        return false;
+    }
+    if (options.command == "convert" && options.targetFormat != "esc" && options.targetFormat != "escb") {
+        std::cerr << "convert precisa de --to esc ou --to escb" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void BatchTool::printUsage() {
+    std::cerr << "Uso:\n"
+              << "  editor --batch convert [--entities <dir>] [--jobs <n>] --to <esc|escb> <cena>...\n"
+              << "      Converte cenas entre .esc e .escb; a saída fica ao lado da entrada.\n"
+              << "  editor --batch validate [--jobs <n>] <diretório de entidades>...\n"
+              << "      Verifica os .ent (XML, textura, atlas e recortes).\n"
+              << "  editor --batch bench [--out <json>] [--library-size <n>] [--sizes <n,n,...>]\n"
+              << "                       [--seed <n>] [--frames <n>] [--work <dir>]\n"
+              << "      Gera biblioteca e cenas sintéticas e mede os caminhos críticos." << std::endl;
+}
+
+int BatchTool::convert(const Options& options) {
+    sf::Clock total;
+
+    if (!fs::is_directory(options.entitiesDirectory)) {
+        std::cerr << "Diretório de entidades não encontrado: " << options.entitiesDirectory << std::endl;
+        return 1;
+    }
+
+    // As entidades são só lidas durante a conversão; o mesmo EntityManager
+    // atende todas as threads
+    EntityManager entityManager;
+    entityManager.loadEntitiesFromDirectory(options.entitiesDirectory);
+    std::cout << entityManager.getEntities().size() << " entidades carregadas de " << options.entitiesDirectory
+              << " em " << formatMilliseconds(total.getElapsedTime()) << std::endl;
+
+    ThreadPool pool(options.jobs);
+    std::vector<std::future<TaskReport>> reports;
+    for (const std::string& input : options.inputs) {
+        reports.push_back(pool.submit([&entityManager, &options, input]() {
+            TaskReport report;
+            sf::Clock clock;
+            std::string output = fs::path(input).replace_extension("." + options.targetFormat).string();
+            if (output == input) {
+                report.ok = false;
+                report.text = input + ": já está no formato ." + options.targetFormat + "\n";
+                return report;
+            }
+
+            ChunkedScene scene;
+            std::size_t skipped = 0;
+            if (fs::path(input).extension() == ".esc") {
+                SceneImporter importer;
+                report.ok = importer.importEsc(input, scene, entityManager);
+                skipped = importer.getSkippedCount();
+            } else {
+                report.ok = BinaryScene::load(input, scene, entityManager, true, &skipped);
+            }
+            sf::Time loadTime = clock.restart();
+
+            // Nenhuma entidade resolvida: quase sempre o --entities errado; não grava uma cena vazia
+            bool nothingResolved = report.ok && skipped > 0 && scene.size() == 0;
+            if (nothingResolved) {
+                report.ok = false;
+            }
+
+            if (report.ok) {
+                if (options.targetFormat == "esc") {
+                    // Uma thread por arquivo já ocupa o pool; a exportação fica serial
+                    SceneExporter exporter(1);
+                    report.ok = exporter.exportEsc(output, scene, entityManager);
+                } else {
+                    report.ok = BinaryScene::save(output, scene, entityManager);
+                }
+            }
+
+            std::ostringstream text;
+            if (report.ok) {
+                text << input << " -> " << output << ": " << scene.size() << " instâncias";
+                if (skipped > 0) text << " (" << skipped << " ignoradas)";
+                text << ", leitura " << formatMilliseconds(loadTime) << ", gravação "
+                     << formatMilliseconds(clock.getElapsedTime()) << "\n";
+            } else if (nothingResolved) {
+                text << input << ": nenhuma das " << skipped << " instâncias corresponde a uma entidade de "
+                     << options.entitiesDirectory << "\n";
+            } else {
+                text << input << ": falha na conversão\n";
+            }
+            report.text = text.str();
+            return report;
+        }));
+    }
+
+    return printReports(reports, total, "cena(s)");
+}
+
+int BatchTool::validate(const Options& options) {
+    sf::Clock total;
+
+    std::vector<std::string> files;
+    for (const std::string& directory : options.inputs) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->path().extension() == ".ent") {
+                files.push_back(it->path().string());
+            }
+        }
+        if (ec) {
+            std::cerr << "Não foi possível ler " << directory << ": " << ec.message() << std::endl;
+            return 1;
+        }
+    }
+
+    ThreadPool pool(options.jobs);
+    std::vector<std::future<TaskReport>> reports;
+    for (const std::string& file : files) {
+        reports.push_back(pool.submit([file]() {
+            TaskReport report;
+            std::ostringstream problems;
+
+            EntityDefinition definition;
+            if (!Entity::parseDefinition(file, definition)) {
+                report.ok = false;
+                report.text = file + ": XML inválido\n";
+                return report;
+            }
+
+            if (!definition.spritePath.empty()) {
+                if (!TextureCache::readImageSize(definition.texturePath, definition.textureSize) ||
+                    definition.textureSize.x == 0 || definition.textureSize.y == 0) {
+                    problems << "  textura ilegível: " << definition.texturePath << "\n";
+                } else if (definition.hasAtlas) {
+                    sf::IntRect bounds(0, 0, definition.textureSize.x, definition.textureSize.y);
+                    for (const auto& sprite : definition.spriteDefinitions) {
+                        sf::IntRect clipped;
+                        if (!bounds.intersects(sprite.rect, clipped) || clipped != sprite.rect) {
+                            problems << "  recorte '" << sprite.name << "' fora da textura\n";
+                        }
+                    }
+                } else if (definition.textureSize.x % definition.cutX != 0 ||
+                           definition.textureSize.y % definition.cutY != 0) {
+                    problems << "  SpriteCut " << definition.cutX << "x" << definition.cutY
+                             << " não divide a textura " << definition.textureSize.x << "x"
+                             << definition.textureSize.y << "\n";
+                }
+            } else if (definition.collisionSize.x <= 0 || definition.collisionSize.y <= 0) {
+                problems << "  sem sprite e sem tamanho de colisão\n";
+            }
+
+            report.ok = problems.tellp() == 0;
+            if (!report.ok) {
+                report.text = file + ":\n" + problems.str();
+            }
+            return report;
+        }));
+    }
+
+    return printReports(reports, total, "entidade(s)");
+}
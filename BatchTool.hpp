@@ -0,0 +1,34 @@
+#pragma once
+#include "Benchmark.hpp"
+#include <string>
+#include <vector>
+
+// Modo de linha de comando sem janela nem contexto OpenGL, para rodar o
+// pipeline de assets em máquinas de build. Usa o mesmo EntityManager,
+// importadores e exportadores do editor; cada arquivo é processado numa
+// thread do pool.
+//
+//   editor --batch convert [--entities <dir>] [--jobs <n>] --to <esc|escb> <cena>...
+//   editor --batch validate [--jobs <n>] <diretório de entidades>...
+//   editor --batch bench [--out <json>] [--library-size <n>] [--sizes <n,n,...>]
+//                        [--seed <n>] [--frames <n>] [--work <dir>]
+class BatchTool {
+public:
+    // args sem o "--batch"; retorna o código de saída do processo
+    static int run(const std::vector<std::string>& args);
+
+private:
+    struct Options {
+        std::string command;
+        std::string entitiesDirectory = "entities";
+        std::string targetFormat;  // "esc" ou "escb"
+        std::size_t jobs = 0;      // 0 = uma thread por núcleo
+        std::vector<std::string> inputs;
+        Benchmark::Options bench;
+    };
+
+    static bool parseOptions(const std::vector<std::string>& args, Options& options);
+    static void printUsage();
+    static int convert(const Options& options);
+    static int validate(const Options& options);
+};
@@ -0,0 +1,378 @@
+#include "Benchmark.hpp"
+#include "BinaryScene.hpp"
+#include "Log.hpp"
+#include "SceneExporter.hpp"
+#include "SceneImporter.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::size_t TextureCount = 16;
+const unsigned AtlasCell = 128;    // Como em utree-blocks-basic.xml: células de 128 com borda de 2
+const unsigned AtlasPadding = 2;
+const float CellSize = 32.0f;
+const sf::Vector2u RenderSize(1024, 768);
+
+// std::uniform_int_distribution varia entre bibliotecas padrão; o módulo
+// sobre mt19937 (cuja sequência é fixada pela norma) mantém a reprodutibilidade
+std::uint32_t pick(std::mt19937& rng, std::uint32_t count) {
+    return count == 0 ? 0 : rng() % count;
+}
+
+std::string libraryEntityName(std::size_t index) {
+    std::ostringstream name;
+    name << "bench_" << std::setw(6) << std::setfill('0') << index << ".ent";
+    return name.str();
+}
+
+bool writeTexture(const std::string& path, unsigned width, unsigned height, std::mt19937& rng) {
+    sf::Image image;
+    image.create(width, height, sf::Color(pick(rng, 256), pick(rng, 256), pick(rng, 256)));
+    return image.saveToFile(path);
+}
+
+bool writeAtlas(const std::string& path, const std::string& imageName, unsigned columns, unsigned rows) {
+    std::ofstream out(path, std::ios::trunc);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<TextureAtlas imagePath=\"" << imageName << "\" width=\"" << columns * (AtlasCell + AtlasPadding) + AtlasPadding
+        << "\" height=\"" << rows * (AtlasCell + AtlasPadding) + AtlasPadding << "\">\n";
+    for (unsigned y = 0; y < rows; ++y) {
+        for (unsigned x = 0; x < columns; ++x) {
+            out << "    <sprite n=\"cell-" << y * columns + x << ".png\" x=\"" << AtlasPadding + x * (AtlasCell + AtlasPadding)
+                << "\" y=\"" << AtlasPadding + y * (AtlasCell + AtlasPadding) << "\" w=\"" << AtlasCell << "\" h=\"" << AtlasCell
+                << "\" oX=\"0\" oY=\"0\" oW=\"" << AtlasCell << "\" oH=\"" << AtlasCell << "\"/>\n";
+        }
+    }
+    out << "</TextureAtlas>\n";
+    return static_cast<bool>(out);
+}
+
+bool writeEntity(const std::string& path, const std::string& sprite, unsigned cutX, unsigned cutY, unsigned collision) {
+    std::ofstream out(path, std::ios::trunc);
+    out << "<?xml version=\"1.0\" ?>\n<Ethanon>\n    <Entity shape=\"1\" static=\"1\">\n";
+    if (!sprite.empty()) {
+        out << "        <SpriteCut x=\"" << cutX << "\" y=\"" << cutY << "\" />\n"
+            << "        <Sprite>" << sprite << "</Sprite>\n";
+    }
+    out << "        <Collision>\n            <Position x=\"0\" y=\"0\" z=\"0\" />\n"
+        << "            <Size x=\"" << collision << "\" y=\"" << collision << "\" z=\"1\" />\n        </Collision>\n"
+        << "        <CustomData>\n            <Variable>\n                <Type>string</Type>\n"
+        << "                <Name>material</Name>\n                <Value>stone</Value>\n"
+        << "            </Variable>\n        </CustomData>\n    </Entity>\n</Ethanon>\n";
+    return static_cast<bool>(out);
+}
+
+}
+
+Benchmark::Benchmark(const Options& options) : options(options) {
+    if (this->options.workDirectory.empty()) {
+        this->options.workDirectory = fs::temp_directory_path().string();
+    }
+}
+
+bool Benchmark::generateLibrary(const std::string& directory, std::size_t entityCount, std::uint32_t seed) {
+    std::error_code ec;
+    if (fs::exists(directory, ec) && !fs::is_empty(directory, ec)) {
+        std::cerr << "Diretório não vazio, a biblioteca sintética não será gerada nele: " << directory << std::endl;
+        return false;
+    }
+    fs::create_directories(directory, ec);
+    if (ec) return false;
+
+    std::mt19937 rng(seed);
+
+    // Texturas pares ganham atlas XML; as ímpares são divididas só pelo SpriteCut
+    struct TextureInfo { std::string name; unsigned columns; unsigned rows; };
+    std::vector<TextureInfo> textures;
+    for (std::size_t i = 0; i < TextureCount; ++i) {
+        TextureInfo texture{"texture-" + std::to_string(i) + ".png", 2 + pick(rng, 7), 1 + pick(rng, 4)};
+        fs::path base = fs::path(directory) / texture.name;
+        unsigned width = texture.columns * (AtlasCell + AtlasPadding) + AtlasPadding;
+        unsigned height = texture.rows * (AtlasCell + AtlasPadding) + AtlasPadding;
+        if (!writeTexture(base.string(), width, height, rng)) return false;
+        if (i % 2 == 0 && !writeAtlas(fs::path(base).replace_extension(".xml").string(), texture.name,
+                                      texture.columns, texture.rows)) {
+            return false;
+        }
+        textures.push_back(texture);
+    }
+
+    for (std::size_t i = 0; i < entityCount; ++i) {
+        std::string path = (fs::path(directory) / libraryEntityName(i)).string();
+
+        // Uma em cada dez é invisível (só colisão), como os solid_box
+        bool ok;
+        if (pick(rng, 10) == 0) {
+            ok = writeEntity(path, "", 1, 1, 32 * (1 + pick(rng, 4)));
+        } else {
+            const TextureInfo& texture = textures[pick(rng, TextureCount)];
+            ok = writeEntity(path, texture.name, texture.columns, texture.rows, AtlasCell);
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+void Benchmark::generateScene(const EntityManager& entityManager, std::size_t instanceCount, std::uint32_t seed,
+                              std::vector<PlacedSample>& out) {
+    out.clear();
+
+    // Os ids seguem a ordem em que as threads terminam de carregar; a escolha
+    // é feita pelo nome do arquivo para não depender dela
+    std::vector<PrototypeId> prototypes;
+    for (std::size_t i = 0; i < entityManager.getEntities().size(); ++i) {
+        PrototypeId id = entityManager.getEntityIdByPath(libraryEntityName(i));
+        if (id != InvalidPrototypeId) {
+            prototypes.push_back(id);
+        }
+    }
+    if (prototypes.empty()) return;
+
+    // Densidade de uma instância a cada ~4 células, numa área quadrada
+    std::mt19937 rng(seed);
+    std::uint32_t side = static_cast<std::uint32_t>(std::ceil(std::sqrt(instanceCount * 4.0)));
+    out.reserve(instanceCount);
+    for (std::size_t i = 0; i < instanceCount; ++i) {
+        PrototypeId id = prototypes[pick(rng, static_cast<std::uint32_t>(prototypes.size()))];
+        const Entity* entity = entityManager.getEntityById(id);
+        std::uint32_t frames = static_cast<std::uint32_t>(std::max<std::size_t>(1, entity->getSpriteDefinitions().size()));
+        sf::Vector2f position(pick(rng, side) * CellSize, pick(rng, side) * CellSize);
+        out.push_back({id, position, static_cast<int>(pick(rng, frames))});
+    }
+}
+
+bool Benchmark::createBenchDirectory() {
+    std::error_code ec;
+    fs::create_directories(options.workDirectory, ec);
+
+    // create_directory só retorna true se criou agora: o diretório nunca é de outra pessoa
+    std::string base = "editor-bench-" + std::to_string(options.seed);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        fs::path candidate = fs::path(options.workDirectory) / (attempt == 0 ? base : base + "-" + std::to_string(attempt));
+        if (fs::create_directory(candidate, ec)) {
+            benchDirectory = candidate.string();
+            libraryDirectory = (candidate / "entities").string();
+            return true;
+        }
+        if (ec) break;
+    }
+    std::cerr << "Não foi possível criar um diretório de trabalho novo em " << options.workDirectory << std::endl;
+    return false;
+}
+
+bool Benchmark::run() {
+    // Progresso e log em stderr: em stdout sai só o JSON
+    Log::setStdoutAllowed(false);
+    if (!createBenchDirectory()) {
+        return false;
+    }
+
+    bool ok = runAll();
+
+    std::error_code ec;
+    fs::remove_all(benchDirectory, ec);
+    return ok && writeJson();
+}
+
+bool Benchmark::runAll() {
+    std::cerr << "Gerando biblioteca sintética (" << options.librarySize << " entidades) em " << libraryDirectory << std::endl;
+    if (!generateLibrary(libraryDirectory, options.librarySize, options.seed)) {
+        std::cerr << "Falha ao gerar a biblioteca em " << libraryDirectory << std::endl;
+        return false;
+    }
+
+    benchmarkLoading();
+
+    EntityManager entityManager;
+    entityManager.loadEntitiesFromDirectory(libraryDirectory);
+    if (entityManager.getEntities().empty()) {
+        std::cerr << "Nenhuma entidade da biblioteca sintética pôde ser carregada" << std::endl;
+        return false;
+    }
+    bool ok = true;
+    for (std::size_t size : options.sceneSizes) {
+        ok = benchmarkScene(entityManager, size) && ok;
+    }
+    return ok;
+}
+
+void Benchmark::benchmarkLoading() {
+    // Sem .entity_cache: todos os XML são interpretados e as imagens lidas
+    std::error_code ec;
+    fs::remove(fs::path(libraryDirectory) / ".entity_cache", ec);
+    {
+        EntityManager entityManager;
+        sf::Clock clock;
+        entityManager.loadEntitiesFromDirectory(libraryDirectory);
+        record("load_entities_cold", options.librarySize, options.librarySize, clock.getElapsedTime());
+    }
+    {
+        EntityManager entityManager;
+        sf::Clock clock;
+        entityManager.loadEntitiesFromDirectory(libraryDirectory);
+        record("load_entities_cached", options.librarySize, options.librarySize, clock.getElapsedTime());
+    }
+}
+
+bool Benchmark::benchmarkScene(const EntityManager& entityManager, std::size_t instanceCount) {
+    std::vector<PlacedSample> samples;
+    generateScene(entityManager, instanceCount, options.seed + static_cast<std::uint32_t>(instanceCount), samples);
+
+    // O mesmo que Editor::placeEntity faz por clique, sem a janela: amostras que
+    // caem numa célula ocupada trocam ou mantêm a instância, então a cena fica
+    // menor que instanceCount e os resultados seguintes usam o tamanho real
+    ChunkedScene scene;
+    scene.setCellSize(CellSize);
+    sf::Clock clock;
+    for (const PlacedSample& sample : samples) {
+        const Entity* entity = entityManager.getEntityById(sample.prototypeId);
+        scene.place(sample.prototypeId, sample.position, entity->getFrameSize(sample.spriteFrame), sample.spriteFrame);
+    }
+    std::size_t sceneSize = scene.size();
+    record("place", sceneSize, samples.size(), clock.getElapsedTime());
+    bool ok = true;
+
+    // Quadros fora da tela: parado (lotes em cache) e com a câmera andando (lotes refeitos)
+    sf::RenderTexture target;
+    if (target.create(RenderSize.x, RenderSize.y)) {
+        float side = std::ceil(std::sqrt(instanceCount * 4.0)) * CellSize;
+        sf::View view(sf::Vector2f(side / 2, side / 2), sf::Vector2f(RenderSize));
+        target.setView(view);
+
+        // Como no editor: uma entidade invisível no centro da tela, com o ícone
+        // sobreposto vindo de uma textura já carregada (EditorResources faz isso na abertura)
+        sf::Image overlayImage;
+        overlayImage.create(AtlasCell, AtlasCell, sf::Color(255, 0, 255, 128));
+        sf::Texture overlay;
+        overlay.loadFromImage(overlayImage);
+        scene.setOverlayTexture(&overlay);
+        for (std::size_t i = 0; i < entityManager.getEntities().size(); ++i) {
+            const Entity* entity = entityManager.getEntityById(static_cast<PrototypeId>(i));
+            if (!entity->hasSprite()) {
+                sf::Vector2f cell(std::floor(view.getCenter().x / CellSize) * CellSize,
+                                  std::floor(view.getCenter().y / CellSize) * CellSize);
+                scene.place(static_cast<PrototypeId>(i), cell, entity->getFrameSize(0), 0);
+                sceneSize = scene.size();
+                break;
+            }
+        }
+
+        auto visibleArea = [&]() {
+            return sf::FloatRect(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+        };
+        auto frame = [&]() {
+            scene.updateStreaming(visibleArea());
+            target.clear(sf::Color::White);
+            scene.render(target, entityManager, visibleArea());
+            target.display();
+        };
+
+        clock.restart();
+        frame();
+        record("render_first_frame", sceneSize, 1, clock.getElapsedTime());
+
+        const TextureCache& textureCache = entityManager.getTextureCache();
+        std::size_t loadsBefore = textureCache.getLoadCount();
+        clock.restart();
+        for (int i = 0; i < options.renderFrames; ++i) {
+            frame();
+        }
+        record("render_frame_static", sceneSize, options.renderFrames, clock.getElapsedTime());
+        if (textureCache.getLoadCount() != loadsBefore) {
+            std::cerr << "ERRO: quadros parados leram " << textureCache.getLoadCount() - loadsBefore
+                      << " texturas do disco (" << sceneSize << " instâncias)" << std::endl;
+            ok = false;
+        }
+
+        clock.restart();
+        for (int i = 0; i < options.renderFrames; ++i) {
+            view.move(CellSize / 2, CellSize / 4);
+            target.setView(view);
+            frame();
+        }
+        record("render_frame_pan", sceneSize, options.renderFrames, clock.getElapsedTime());
+        scene.setOverlayTexture(nullptr);
+    } else {
+        std::cerr << "Sem contexto OpenGL; benchmarks de renderização ignorados" << std::endl;
+    }
+
+    std::string escPath = (fs::path(benchDirectory) / "scene.esc").string();
+    std::string escbPath = (fs::path(benchDirectory) / "scene.escb").string();
+
+    SceneExporter exporter;
+    clock.restart();
+    exporter.exportEsc(escPath, scene, entityManager);
+    record("export_esc", sceneSize, sceneSize, clock.getElapsedTime());
+
+    clock.restart();
+    BinaryScene::save(escbPath, scene, entityManager);
+    record("save_escb", sceneSize, sceneSize, clock.getElapsedTime());
+
+    {
+        ChunkedScene imported;
+        imported.setCellSize(CellSize);
+        SceneImporter importer;
+        clock.restart();
+        importer.importEsc(escPath, imported, entityManager);
+        record("import_esc", sceneSize, sceneSize, clock.getElapsedTime());
+    }
+    {
+        ChunkedScene loaded;
+        loaded.setCellSize(CellSize);
+        clock.restart();
+        BinaryScene::load(escbPath, loaded, entityManager);
+        record("load_escb", sceneSize, sceneSize, clock.getElapsedTime());
+    }
+    return ok;
+}
+
+void Benchmark::record(const std::string& name, std::size_t size, std::size_t iterations, sf::Time time) {
+    Result result{name, size, iterations, time.asMicroseconds() / 1000.0};
+    results.push_back(result);
+    std::cerr << std::left << std::setw(24) << name << std::right << std::setw(9) << size << "  "
+              << std::fixed << std::setprecision(3) << result.totalMs << " ms";
+    if (iterations > 1) {
+        std::cerr << "  (" << result.totalMs * 1000.0 / iterations << " us/iteração)";
+    }
+    std::cerr << std::defaultfloat << std::endl;
+}
+
+bool Benchmark::writeJson() const {
+    std::ostringstream json;
+    json << "{\n  \"benchmark\": \"editor\",\n  \"formatVersion\": 1,\n  \"seed\": " << options.seed
+         << ",\n  \"librarySize\": " << options.librarySize << ",\n  \"renderFrames\": " << options.renderFrames
+         << ",\n  \"results\": [\n";
+    json << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        json << "    {\"name\": \"" << result.name << "\", \"size\": " << result.size
+             << ", \"iterations\": " << result.iterations << ", \"totalMs\": " << result.totalMs
+             << ", \"perIterationUs\": " << (result.iterations ? result.totalMs * 1000.0 / result.iterations : 0.0)
+             << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    if (options.outputPath.empty()) {
+        std::cout << json.str();
+        return true;
+    }
+
+    std::ofstream out(options.outputPath, std::ios::trunc);
+    out << json.str();
+    if (!out) {
+        std::cerr << "Não foi possível gravar " << options.outputPath << std::endl;
+        return false;
+    }
+    std::cerr << "Resultados gravados em " << options.outputPath << std::endl;
+    return true;
+}
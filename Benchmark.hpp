@@ -0,0 +1,65 @@
+#pragma once
+#include "ChunkedScene.hpp"
+#include "EntityManager.hpp"
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Benchmarks reprodutíveis dos caminhos críticos do editor.
+// Gera uma biblioteca sintética de entidades (texturas com SpriteCut e com
+// atlas XML, além de entidades invisíveis) e cenas de tamanhos variados a
+// partir de uma semente fixa, mede carregamento, colocação, quadros de
+// renderização fora da tela, exportação e importação, e grava os resultados
+// em JSON para comparar versões.
+class Benchmark {
+public:
+    struct Options {
+        // Onde criar o diretório de trabalho próprio (editor-bench-<semente>[-n]),
+        // apagado ao final; nada fora dele é tocado. Vazio = temporário do sistema
+        std::string workDirectory;
+        std::string outputPath;     // JSON; vazio = saída padrão (o progresso vai para stderr)
+        std::size_t librarySize = 500;
+        std::vector<std::size_t> sceneSizes = {1000, 10000, 100000, 1000000};
+        std::uint32_t seed = 1;
+        int renderFrames = 120;
+    };
+
+    explicit Benchmark(const Options& options);
+
+    bool run();
+
+    // Os geradores só dependem da semente: a mesma semente gera os mesmos arquivos e cenas.
+    // generateLibrary recusa um diretório que já exista com conteúdo
+    // generateScene escolhe entre as entidades bench_NNNNNN.ent pelo nome, não pelo id
+    static bool generateLibrary(const std::string& directory, std::size_t entityCount, std::uint32_t seed);
+
+    struct PlacedSample {
+        PrototypeId prototypeId;
+        sf::Vector2f position;
+        int spriteFrame;
+    };
+    static void generateScene(const EntityManager& entityManager, std::size_t instanceCount, std::uint32_t seed,
+                              std::vector<PlacedSample>& out);
+
+private:
+    struct Result {
+        std::string name;
+        std::size_t size;        // Entidades ou instâncias envolvidas
+        std::size_t iterations;  // Repetições medidas (quadros, instâncias colocadas...)
+        double totalMs;
+    };
+
+    void benchmarkLoading();
+    // false se algum quadro parado leu arquivo (o caminho de renderização estável não faz E/S)
+    bool benchmarkScene(const EntityManager& entityManager, std::size_t instanceCount);
+    void record(const std::string& name, std::size_t size, std::size_t iterations, sf::Time time);
+    bool writeJson() const;
+    bool createBenchDirectory();
+    bool runAll();
+
+    Options options;
+    std::string benchDirectory;  // Criado por run() e só ele é apagado
+    std::string libraryDirectory;
+    std::vector<Result> results;
+};
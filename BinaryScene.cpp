@@ -0,0 +1,280 @@
+#include "BinaryScene.hpp"
+#include "Log.hpp"
+#include "MappedFile.hpp"
+#include "Profiler.hpp"
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace BinarySceneFormat;
+
+namespace {
+
+std::uint64_t alignTo8(std::uint64_t offset) {
+    return (offset + 7) & ~static_cast<std::uint64_t>(7);
+}
+
+// Tabela de strings sem repetição
+class StringTable {
+public:
+    std::uint32_t intern(std::string_view text) {
+        auto it = indices.find(std::string(text));
+        if (it != indices.end()) {
+            return it->second;
+        }
+
+        std::uint32_t index = static_cast<std::uint32_t>(entries.size());
+        entries.push_back({static_cast<std::uint32_t>(data.size()), static_cast<std::uint32_t>(text.size())});
+        data.append(text.data(), text.size());
+        indices.emplace(std::string(text), index);
+        return index;
+    }
+
+    const std::vector<StringEntry>& getEntries() const { return entries; }
+    const std::string& getData() const { return data; }
+
+private:
+    std::unordered_map<std::string, std::uint32_t> indices;
+    std::vector<StringEntry> entries;
+    std::string data;
+};
+
+// As seções são gravadas em sequência; os espaços de alinhamento ficam zerados
+void padTo(std::ofstream& out, std::uint64_t offset) {
+    static const char zeros[8] = {};
+    std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+    if (offset > position) {
+        out.write(zeros, static_cast<std::streamsize>(offset - position));
+    }
+}
+
+template <typename T>
+void writeSection(std::ofstream& out, std::uint64_t offset, const std::vector<T>& records) {
+    padTo(out, offset);
+    if (!records.empty()) {
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+    }
+}
+
+// Valida que uma seção cabe inteira no arquivo mapeado
+template <typename T>
+const T* sectionAt(const MappedFile& file, std::uint64_t offset, std::uint64_t count) {
+    if (offset % alignof(T) != 0 || offset > file.size() || count > (file.size() - offset) / sizeof(T)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+// Monta as seções do arquivo a partir dos chunks, em ordem
+class SceneFileBuilder {
+public:
+    // nameOf(prototypeId) devolve o nome da entidade, ou nullptr se desconhecida
+    template <typename NameLookup>
+    void addChunk(const ChunkCoord& coord, const InstanceData& data, NameLookup nameOf) {
+        ChunkEntry chunk{coord.x, coord.y, static_cast<std::uint32_t>(records.size()), 0};
+
+        for (std::size_t i = 0; i < data.instances.size(); ++i) {
+            const PlacedInstance& instance = data.instances[i];
+            auto nameIt = nameIndexByPrototype.find(instance.prototypeId);
+            if (nameIt == nameIndexByPrototype.end()) {
+                const std::string* name = nameOf(instance.prototypeId);
+                if (!name) continue;
+                nameIt = nameIndexByPrototype.emplace(instance.prototypeId, strings.intern(*name)).first;
+            }
+
+            InstanceRecord record{nameIt->second, instance.x, instance.y, instance.spriteFrame, NoOverride,
+                                  instance.sequence};
+            if (const auto* values = data.getOverrides(i)) {
+                overrides.push_back({static_cast<std::uint32_t>(overridePairs.size()), static_cast<std::uint32_t>(values->size())});
+                for (const auto& entry : *values) {
+                    overridePairs.push_back({strings.intern(entry.first), strings.intern(entry.second)});
+                }
+                record.overrideIndex = static_cast<std::uint32_t>(overrides.size());
+            }
+            records.push_back(record);
+        }
+
+        chunk.instanceCount = static_cast<std::uint32_t>(records.size()) - chunk.firstInstance;
+        if (chunk.instanceCount > 0) {
+            chunkDirectory.push_back(chunk);
+        }
+    }
+
+    void reserve(std::size_t instanceCount) { records.reserve(instanceCount); }
+
+    bool write(const std::string& filename) const {
+        Header header = {};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.version = Version;
+        header.stringCount = static_cast<std::uint32_t>(strings.getEntries().size());
+        header.chunkCount = static_cast<std::uint32_t>(chunkDirectory.size());
+        header.instanceCount = records.size();
+        header.overrideCount = static_cast<std::uint32_t>(overrides.size());
+        header.overridePairCount = static_cast<std::uint32_t>(overridePairs.size());
+
+        header.stringEntriesOffset = alignTo8(sizeof(Header));
+        header.stringDataOffset = header.stringEntriesOffset + strings.getEntries().size() * sizeof(StringEntry);
+        header.chunkDirectoryOffset = alignTo8(header.stringDataOffset + strings.getData().size());
+        header.instancesOffset = alignTo8(header.chunkDirectoryOffset + chunkDirectory.size() * sizeof(ChunkEntry));
+        header.overridesOffset = alignTo8(header.instancesOffset + records.size() * sizeof(InstanceRecord));
+        header.overridePairsOffset = alignTo8(header.overridesOffset + overrides.size() * sizeof(OverrideEntry));
+        header.fileSize = header.overridePairsOffset + overridePairs.size() * sizeof(OverridePair);
+
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeSection(out, header.stringEntriesOffset, strings.getEntries());
+        padTo(out, header.stringDataOffset);
+        out.write(strings.getData().data(), strings.getData().size());
+        writeSection(out, header.chunkDirectoryOffset, chunkDirectory);
+        writeSection(out, header.instancesOffset, records);
+        writeSection(out, header.overridesOffset, overrides);
+        writeSection(out, header.overridePairsOffset, overridePairs);
+
+        out.close();
+        return !out.fail();
+    }
+
+private:
+    StringTable strings;
+    std::vector<ChunkEntry> chunkDirectory;
+    std::vector<InstanceRecord> records;
+    std::vector<OverrideEntry> overrides;
+    std::vector<OverridePair> overridePairs;
+    std::unordered_map<PrototypeId, std::uint32_t> nameIndexByPrototype;
+};
+
+}
+
+bool BinaryScene::save(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager) {
+    PROFILE_SCOPE("saveBinaryScene");
+    SceneFileBuilder builder;
+    builder.reserve(scene.size());
+    bool complete = scene.forEachChunk([&](const ChunkCoord& coord, const InstanceStore& store) {
+        builder.addChunk(coord, *store.share(), [&](PrototypeId id) -> const std::string* {
+            return entityManager.getEntityPath(id);
+        });
+    });
+    if (!complete) {
+        // Gravar sem os chunks ilegíveis apagaria o conteúdo deles do arquivo
+        LOG_ERROR("Cena binária não gravada: há chunks que não puderam ser lidos. " << filename);
+        return false;
+    }
+    return builder.write(filename);
+}
+
+bool BinaryScene::save(const std::string& filename, const std::vector<ChunkSnapshot>& chunks,
+                       const std::vector<std::string>& prototypeNames) {
+    SceneFileBuilder builder;
+    for (const auto& chunk : chunks) {
+        if (!chunk.data) continue;
+        builder.addChunk(chunk.coord, *chunk.data, [&](PrototypeId id) -> const std::string* {
+            return id < prototypeNames.size() ? &prototypeNames[id] : nullptr;
+        });
+    }
+    return builder.write(filename);
+}
+
+bool BinaryScene::load(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager,
+                       bool replaceScene, std::size_t* skippedCount) {
+    PROFILE_SCOPE("loadBinaryScene");
+    MappedFile file;
+    if (!file.open(filename) || file.size() < sizeof(Header)) {
+        LOG_ERROR("Não foi possível abrir a cena binária: " << filename);
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(file.data());
+    if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->version != Version ||
+        header->fileSize != file.size()) {
+        LOG_ERROR("Cena binária inválida ou de outra versão: " << filename);
+        return false;
+    }
+
+    const StringEntry* stringEntries = sectionAt<StringEntry>(file, header->stringEntriesOffset, header->stringCount);
+    const ChunkEntry* chunkDirectory = sectionAt<ChunkEntry>(file, header->chunkDirectoryOffset, header->chunkCount);
+    const InstanceRecord* records = sectionAt<InstanceRecord>(file, header->instancesOffset, header->instanceCount);
+    const OverrideEntry* overrides = sectionAt<OverrideEntry>(file, header->overridesOffset, header->overrideCount);
+    const OverridePair* overridePairs = sectionAt<OverridePair>(file, header->overridePairsOffset, header->overridePairCount);
+    if ((header->stringCount && !stringEntries) || (header->chunkCount && !chunkDirectory) ||
+        (header->instanceCount && !records) || (header->overrideCount && !overrides) ||
+        (header->overridePairCount && !overridePairs) || header->stringDataOffset > file.size()) {
+        LOG_ERROR("Cena binária truncada: " << filename);
+        return false;
+    }
+
+    const char* stringData = file.data() + header->stringDataOffset;
+    std::size_t stringDataSize = file.size() - header->stringDataOffset;
+    auto stringAt = [&](std::uint32_t index) -> std::string_view {
+        if (index >= header->stringCount) return std::string_view();
+        const StringEntry& entry = stringEntries[index];
+        if (entry.offset > stringDataSize || entry.length > stringDataSize - entry.offset) return std::string_view();
+        return std::string_view(stringData + entry.offset, entry.length);
+    };
+
+    // Resolve cada nome uma única vez
+    std::vector<PrototypeId> prototypes(header->stringCount, InvalidPrototypeId);
+    std::vector<bool> resolved(header->stringCount, false);
+
+    // Tudo o que pode recusar o arquivo é verificado antes de tocar na cena:
+    // um .escb corrompido não deixa a cena aberta apagada nem pela metade
+    for (std::uint32_t c = 0; c < header->chunkCount; ++c) {
+        const ChunkEntry& chunk = chunkDirectory[c];
+        if (chunk.firstInstance > header->instanceCount || chunk.instanceCount > header->instanceCount - chunk.firstInstance) {
+            LOG_ERROR("Diretório de chunks inválido: " << filename);
+            return false;
+        }
+    }
+
+    if (replaceScene) {
+        scene.clear();
+    }
+    std::size_t skipped = 0;
+    for (std::uint32_t c = 0; c < header->chunkCount; ++c) {
+        const ChunkEntry& chunk = chunkDirectory[c];
+        for (std::uint32_t i = 0; i < chunk.instanceCount; ++i) {
+            const InstanceRecord& record = records[chunk.firstInstance + i];
+            if (record.nameIndex >= header->stringCount) {
+                ++skipped;
+                continue;
+            }
+            if (!resolved[record.nameIndex]) {
+                prototypes[record.nameIndex] = entityManager.getEntityIdByPath(std::string(stringAt(record.nameIndex)));
+                resolved[record.nameIndex] = true;
+            }
+
+            PrototypeId prototypeId = prototypes[record.nameIndex];
+            const Entity* entity = entityManager.getEntityById(prototypeId);
+            if (!entity) {
+                ++skipped;
+                continue;
+            }
+
+            InstanceRef ref = scene.add(prototypeId, sf::Vector2f(record.x, record.y),
+                                        entity->getFrameSize(record.spriteFrame), record.spriteFrame, record.sequence);
+
+            if (record.overrideIndex != NoOverride && record.overrideIndex <= header->overrideCount) {
+                const OverrideEntry& entry = overrides[record.overrideIndex - 1];
+                if (entry.firstPair <= header->overridePairCount && entry.pairCount <= header->overridePairCount - entry.firstPair) {
+                    for (std::uint32_t p = 0; p < entry.pairCount; ++p) {
+                        const OverridePair& pair = overridePairs[entry.firstPair + p];
+                        scene.setOverride(ref, std::string(stringAt(pair.key)), std::string(stringAt(pair.value)));
+                    }
+                }
+            }
+        }
+    }
+
+    if (skipped > 0) {
+        LOG_WARNING(skipped << " instâncias ignoradas (entidade não encontrada) em " << filename);
+    }
+    if (skippedCount) {
+        *skippedCount = skipped;
+    }
+    return true;
+}
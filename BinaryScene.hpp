@@ -0,0 +1,89 @@
+#pragma once
+#include "ChunkedScene.hpp"
+#include "EntityManager.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Formato binário da cena de trabalho (.escb).
+// Pensado para ser lido direto de um arquivo mapeado em memória, sem
+// interpretação: todas as seções são arrays de registros de tamanho fixo
+// (little-endian, alinhados a 8 bytes) localizados por offsets no cabeçalho.
+//
+//   BinarySceneHeader
+//   StringEntry[stringCount] + bytes dos textos (nomes de entidades, chaves e valores)
+//   ChunkEntry[chunkCount]          diretório, ordenado por linha e coluna
+//   InstanceRecord[instanceCount]   agrupados por chunk, na ordem do diretório
+//                                   (a ordem de inserção vai em cada registro)
+//   OverrideEntry[overrideCount] + OverridePair[overridePairCount]
+//
+// O .esc (XML do Ethanon) continua sendo o formato de exportação.
+namespace BinarySceneFormat {
+
+constexpr char Magic[4] = {'E', 'S', 'C', 'B'};
+constexpr std::uint32_t Version = 1;
+constexpr std::uint32_t NoOverride = 0;  // overrideIndex de instâncias sem sobrescrita
+
+struct Header {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t stringCount;
+    std::uint32_t chunkCount;
+    std::uint64_t instanceCount;
+    std::uint32_t overrideCount;
+    std::uint32_t overridePairCount;
+    std::uint64_t stringEntriesOffset;
+    std::uint64_t stringDataOffset;
+    std::uint64_t chunkDirectoryOffset;
+    std::uint64_t instancesOffset;
+    std::uint64_t overridesOffset;
+    std::uint64_t overridePairsOffset;
+    std::uint64_t fileSize;
+};
+
+struct StringEntry {
+    std::uint32_t offset;  // Relativo a stringDataOffset
+    std::uint32_t length;
+};
+
+struct ChunkEntry {
+    std::int32_t x;
+    std::int32_t y;
+    std::uint32_t firstInstance;
+    std::uint32_t instanceCount;
+};
+
+struct InstanceRecord {
+    std::uint32_t nameIndex;      // Índice na tabela de strings (caminho do .ent)
+    float x;
+    float y;
+    std::int32_t spriteFrame;
+    std::uint32_t overrideIndex;  // 1 + índice em OverrideEntry, ou NoOverride
+    std::uint32_t sequence;       // PlacedInstance::sequence (ordem de inserção)
+};
+
+struct OverrideEntry {
+    std::uint32_t firstPair;
+    std::uint32_t pairCount;
+};
+
+struct OverridePair {
+    std::uint32_t key;    // Índices na tabela de strings
+    std::uint32_t value;
+};
+
+}
+
+class BinaryScene {
+public:
+    static bool save(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager);
+    // Grava chunks capturados por ChunkedScene::takeSnapshot (pode rodar em outra thread);
+    // chunks sem dados são omitidos. prototypeNames[id] = EntityManager::getEntityPath(id)
+    static bool save(const std::string& filename, const std::vector<ChunkSnapshot>& chunks,
+                     const std::vector<std::string>& prototypeNames);
+    // Instâncias de entidades desconhecidas são ignoradas; um arquivo inválido é
+    // recusado sem alterar a cena. Com replaceScene = false, as instâncias são
+    // acrescentadas à cena atual. skippedCount recebe quantas foram ignoradas
+    static bool load(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager,
+                     bool replaceScene = true, std::size_t* skippedCount = nullptr);
+};
@@ -0,0 +1,59 @@
+#include "Camera.hpp"
+#include <algorithm>
+
+Camera::Camera() : screenArea(0, 0, 1, 1), windowSize(1, 1) {
+    updateView();
+}
+
+void Camera::setScreenArea(const sf::FloatRect& area, sf::Vector2u size) {
+    screenArea = area;
+    windowSize = size;
+    reset();
+}
+
+void Camera::reset() {
+    zoom = 1.0f;
+    center = sf::Vector2f(screenArea.width / 2, screenArea.height / 2);
+    updateView();
+}
+
+void Camera::pan(sf::Vector2f screenDelta) {
+    center -= screenDelta * zoom;
+    updateView();
+}
+
+void Camera::zoomAt(sf::Vector2i screenPos, float factor) {
+    // Mantém fixo o ponto do mundo sob o cursor
+    sf::Vector2f before = screenToWorld(screenPos);
+    zoom = std::max(MinZoom, std::min(MaxZoom, zoom * factor));
+    updateView();
+    sf::Vector2f after = screenToWorld(screenPos);
+    center += before - after;
+    updateView();
+}
+
+sf::Vector2f Camera::screenToWorld(sf::Vector2i screenPos) const {
+    sf::Vector2f areaCenter(screenArea.left + screenArea.width / 2, screenArea.top + screenArea.height / 2);
+    return center + (sf::Vector2f(screenPos) - areaCenter) * zoom;
+}
+
+sf::Vector2f Camera::worldToScreen(sf::Vector2f worldPos) const {
+    sf::Vector2f areaCenter(screenArea.left + screenArea.width / 2, screenArea.top + screenArea.height / 2);
+    return areaCenter + (worldPos - center) / zoom;
+}
+
+bool Camera::containsScreenPoint(sf::Vector2i screenPos) const {
+    return screenArea.contains(static_cast<float>(screenPos.x), static_cast<float>(screenPos.y));
+}
+
+sf::FloatRect Camera::getVisibleArea() const {
+    sf::Vector2f size(screenArea.width * zoom, screenArea.height * zoom);
+    return sf::FloatRect(center - size / 2.0f, size);
+}
+
+void Camera::updateView() {
+    view.setCenter(center);
+    view.setSize(screenArea.width * zoom, screenArea.height * zoom);
+    view.setViewport(sf::FloatRect(screenArea.left / windowSize.x, screenArea.top / windowSize.y,
+                                   screenArea.width / windowSize.x, screenArea.height / windowSize.y));
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Câmera da área de edição baseada em sf::View.
+// Converte entre coordenadas de tela (pixels da janela) e de mundo (cena),
+// com pan e zoom ancorado no cursor. Com zoom 1 e sem pan, o canto superior
+// esquerdo da área de edição corresponde à origem do mundo.
+class Camera {
+public:
+    Camera();
+
+    void setScreenArea(const sf::FloatRect& area, sf::Vector2u windowSize);
+    void pan(sf::Vector2f screenDelta);
+    void zoomAt(sf::Vector2i screenPos, float factor);
+    void reset();
+
+    sf::Vector2f screenToWorld(sf::Vector2i screenPos) const;
+    sf::Vector2f worldToScreen(sf::Vector2f worldPos) const;
+    bool containsScreenPoint(sf::Vector2i screenPos) const;
+
+    const sf::View& getView() const { return view; }
+    sf::FloatRect getVisibleArea() const;
+    float getZoom() const { return zoom; }
+
+private:
+    void updateView();
+
+    static constexpr float MinZoom = 0.125f;
+    static constexpr float MaxZoom = 8.0f;
+
+    sf::View view;
+    sf::FloatRect screenArea;
+    sf::Vector2u windowSize;
+    sf::Vector2f center;
+    float zoom = 1.0f;
+};
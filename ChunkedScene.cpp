@@ -0,0 +1,582 @@
+#include "ChunkedScene.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Margens de streaming, em chunks, ao redor da área visível
+const float LoadMarginChunks = 1.0f;
+const float KeepMarginChunks = 3.0f;
+
+sf::FloatRect expandRect(const sf::FloatRect& rect, float margin) {
+    return sf::FloatRect(rect.left - margin, rect.top - margin, rect.width + 2 * margin, rect.height + 2 * margin);
+}
+
+sf::FloatRect uniteRect(const sf::FloatRect& a, const sf::FloatRect& b) {
+    float left = std::min(a.left, b.left);
+    float top = std::min(a.top, b.top);
+    float right = std::max(a.left + a.width, b.left + b.width);
+    float bottom = std::max(a.top + a.height, b.top + b.height);
+    return sf::FloatRect(left, top, right - left, bottom - top);
+}
+
+bool isReady(const std::future<bool>& future) {
+    return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool isReady(const std::future<std::unique_ptr<InstanceStore>>& future) {
+    return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Distingue cenas criadas no mesmo instante (p.ex. em threads do modo em lote)
+std::atomic<unsigned> sceneCounter{0};
+
+}
+
+ChunkedScene::ChunkedScene() {
+    auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    storageDirectory = (fs::temp_directory_path() /
+                        ("editor-chunks-" + std::to_string(stamp) + "-" + std::to_string(sceneCounter++))).string();
+}
+
+ChunkedScene::~ChunkedScene() {
+    clear();
+    std::error_code ec;
+    fs::remove_all(storageDirectory, ec);
+}
+
+void ChunkedScene::setCellSize(float size) {
+    // Deve ser chamado antes de colocar instâncias; os chunks não são reparticionados
+    if (!chunks.empty()) {
+        LOG_WARNING("Tamanho de célula alterado com a cena já populada; ignorado.");
+        return;
+    }
+    cellSize = size;
+}
+
+void ChunkedScene::setOverlayTexture(const sf::Texture* texture) {
+    overlayTexture = texture;
+    for (auto& entry : chunks) {
+        entry.second->renderer.setOverlayTexture(texture);
+    }
+}
+
+ChunkCoord ChunkedScene::chunkAt(sf::Vector2f worldPos) const {
+    return ChunkCoord{static_cast<int>(std::floor(worldPos.x / chunkWorldSize())),
+                      static_cast<int>(std::floor(worldPos.y / chunkWorldSize()))};
+}
+
+sf::FloatRect ChunkedScene::chunkArea(const ChunkCoord& coord) const {
+    return sf::FloatRect(coord.x * chunkWorldSize(), coord.y * chunkWorldSize(), chunkWorldSize(), chunkWorldSize());
+}
+
+std::string ChunkedScene::chunkFilePath(const ChunkCoord& coord) const {
+    return (fs::path(storageDirectory) / ("chunk_" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + ".bin")).string();
+}
+
+sf::FloatRect ChunkedScene::expandForOverhang(const sf::FloatRect& rect) const {
+    // Instâncias pertencem ao chunk do seu canto superior esquerdo, mas podem
+    // invadir os chunks à direita e abaixo
+    return sf::FloatRect(rect.left - maxInstanceSize.x, rect.top - maxInstanceSize.y,
+                         rect.width + maxInstanceSize.x, rect.height + maxInstanceSize.y);
+}
+
+ChunkedScene::Chunk& ChunkedScene::getOrCreateChunk(const ChunkCoord& coord) {
+    auto it = chunks.find(coord);
+    if (it != chunks.end()) {
+        return *it->second;
+    }
+
+    auto chunk = std::make_unique<Chunk>();
+    chunk->coord = coord;
+    chunk->instances.setCellSize(cellSize);
+    chunk->renderer.setOverlayTexture(overlayTexture);
+    Chunk& ref = *chunk;
+    chunks.emplace(coord, std::move(chunk));
+    return ref;
+}
+
+ChunkedScene::Chunk* ChunkedScene::findChunk(const ChunkCoord& coord) const {
+    auto it = chunks.find(coord);
+    return it != chunks.end() ? it->second.get() : nullptr;
+}
+
+std::size_t ChunkedScene::getResidentChunkCount() const {
+    std::size_t count = 0;
+    for (const auto& entry : chunks) {
+        if (entry.second->state == ChunkState::Resident) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void ChunkedScene::requestPageIn(Chunk& chunk) {
+    if (chunk.state == ChunkState::PagingOut) {
+        // A cópia em gravação ainda está na memória; basta recuperá-la
+        chunk.pendingWrite.wait();
+        bool written = chunk.pendingWrite.get();
+        chunk.instances = std::move(*chunk.writingStore);
+        chunk.writingStore.reset();
+        chunk.hasFile = chunk.hasFile || written;
+        chunk.modified = !written;
+        chunk.state = ChunkState::Resident;
+        chunk.renderer.invalidate();
+        return;
+    }
+
+    if (chunk.state != ChunkState::PagedOut) return;
+
+    std::string path = chunkFilePath(chunk.coord);
+    float size = cellSize;
+    chunk.state = ChunkState::Loading;
+    chunk.pendingLoad = std::async(std::launch::async, [path, size]() -> std::unique_ptr<InstanceStore> {
+        PROFILE_SCOPE("pageInChunk");
+        auto store = std::make_unique<InstanceStore>();
+        store->setCellSize(size);
+        std::ifstream in(path, std::ios::binary);
+        if (!in || !store->readFrom(in)) {
+            return nullptr;
+        }
+        return store;
+    });
+}
+
+void ChunkedScene::requestPageOut(Chunk& chunk) {
+    if (chunk.state != ChunkState::Resident) return;
+
+    chunk.renderer.clear();
+
+    if (!chunk.modified && chunk.hasFile) {
+        // O arquivo já reflete o conteúdo; só libera a memória
+        chunk.instances = InstanceStore();
+        chunk.instances.setCellSize(cellSize);
+        chunk.state = ChunkState::PagedOut;
+        return;
+    }
+
+    std::error_code ec;
+    fs::create_directories(storageDirectory, ec);
+
+    if (chunk.lastEdit > lastSnapshotEdit) {
+        chunk.unsnapshottedData = chunk.instances.share();
+    }
+    chunk.writingStore = std::make_shared<InstanceStore>(std::move(chunk.instances));
+    chunk.instances = InstanceStore();
+    chunk.instances.setCellSize(cellSize);
+    chunk.state = ChunkState::PagingOut;
+
+    std::shared_ptr<const InstanceStore> store = chunk.writingStore;
+    std::string path = chunkFilePath(chunk.coord);
+    chunk.pendingWrite = std::async(std::launch::async, [store, path]() {
+        PROFILE_SCOPE("pageOutChunk");
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        return out && store->writeTo(out) && static_cast<bool>(out.flush());
+    });
+}
+
+void ChunkedScene::finishWrite(Chunk& chunk) {
+    bool written = chunk.pendingWrite.get();
+    if (written) {
+        chunk.hasFile = true;
+        chunk.modified = false;
+        chunk.writingStore.reset();
+        chunk.state = ChunkState::PagedOut;
+    } else {
+        LOG_WARNING("Falha ao gravar chunk em " << chunkFilePath(chunk.coord) << "; mantido na memória.");
+        chunk.instances = std::move(*chunk.writingStore);
+        chunk.writingStore.reset();
+        chunk.state = ChunkState::Resident;
+        chunk.renderer.invalidate();
+    }
+}
+
+void ChunkedScene::pollPending(Chunk& chunk) {
+    if (chunk.state == ChunkState::PagingOut && isReady(chunk.pendingWrite)) {
+        finishWrite(chunk);
+    } else if (chunk.state == ChunkState::Loading && isReady(chunk.pendingLoad)) {
+        std::unique_ptr<InstanceStore> store = chunk.pendingLoad.get();
+        if (!store) {
+            // O conteúdo só existe no arquivo: o chunk continua descarregado e
+            // a leitura é repetida no próximo updateStreaming ou acesso
+            if (!chunk.readFailed) {
+                LOG_ERROR("Falha ao ler chunk de " << chunkFilePath(chunk.coord) << "; nova tentativa adiante.");
+            }
+            chunk.readFailed = true;
+            chunk.state = ChunkState::PagedOut;
+            return;
+        }
+        if (chunk.readFailed) {
+            LOG_INFO("Chunk lido de " << chunkFilePath(chunk.coord) << " após falha anterior.");
+            chunk.readFailed = false;
+        }
+        chunk.instances = std::move(*store);
+        chunk.state = ChunkState::Resident;
+        chunk.renderer.invalidate();
+    }
+}
+
+bool ChunkedScene::ensureResident(Chunk& chunk) {
+    if (chunk.state == ChunkState::PagedOut || chunk.state == ChunkState::PagingOut) {
+        requestPageIn(chunk);
+    }
+    if (chunk.state == ChunkState::Loading) {
+        chunk.pendingLoad.wait();
+        pollPending(chunk);
+    }
+    return chunk.state == ChunkState::Resident;
+}
+
+void ChunkedScene::eraseIfEmpty(const ChunkCoord& coord) {
+    Chunk* chunk = findChunk(coord);
+    if (!chunk || chunk->state != ChunkState::Resident || chunk->instanceCount > 0) return;
+
+    if (chunk->hasFile) {
+        std::error_code ec;
+        fs::remove(chunkFilePath(coord), ec);
+    }
+    chunks.erase(coord);
+}
+
+InstanceRef ChunkedScene::add(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame) {
+    return add(prototypeId, position, size, spriteFrame, nextSequence);
+}
+
+InstanceRef ChunkedScene::add(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame,
+                              std::uint32_t sequence) {
+    ChunkCoord coord = chunkAt(position);
+    Chunk& chunk = getOrCreateChunk(coord);
+    if (!ensureResident(chunk)) {
+        LOG_ERROR("Instância não adicionada: o chunk (" << coord.x << ", " << coord.y << ") não pôde ser lido.");
+        return InstanceRef{coord, InvalidInstanceIndex};
+    }
+
+    nextSequence = std::max(nextSequence, sequence + 1);
+    std::size_t index = chunk.instances.add(prototypeId, position, size, spriteFrame, sequence);
+    ++chunk.instanceCount;
+    ++totalInstances;
+    markEdited(chunk);
+
+    sf::FloatRect bounds(position, size);
+    chunk.contentBounds = chunk.hasContent ? uniteRect(chunk.contentBounds, bounds) : bounds;
+    chunk.hasContent = true;
+    maxInstanceSize.x = std::max(maxInstanceSize.x, size.x);
+    maxInstanceSize.y = std::max(maxInstanceSize.y, size.y);
+
+    return InstanceRef{coord, static_cast<std::uint32_t>(index)};
+}
+
+ChunkedScene::PlaceResult ChunkedScene::place(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size,
+                                              int spriteFrame, InstanceRef* placed) {
+    InstanceRef existing;
+    if (!findAnchoredAt(position, existing)) {
+        InstanceRef ref = add(prototypeId, position, size, spriteFrame);
+        if (ref.index == InvalidInstanceIndex) return PlaceResult::Failed;
+        if (placed) *placed = ref;
+        return PlaceResult::Added;
+    }
+
+    const PlacedInstance& current = *get(existing);
+    if (current.prototypeId == prototypeId && current.spriteFrame == spriteFrame) {
+        if (placed) *placed = existing;
+        return PlaceResult::Unchanged;
+    }
+
+    // Adiciona antes de remover: o chunk não fica vazio no meio da troca, e a
+    // nova instância herda o índice e a ordem de inserção da antiga
+    std::uint32_t sequence = current.sequence;
+    add(prototypeId, position, size, spriteFrame, sequence);
+    remove(existing);
+    if (placed) *placed = existing;
+    return PlaceResult::Replaced;
+}
+
+void ChunkedScene::remove(const InstanceRef& ref) {
+    Chunk* chunk = findChunk(ref.chunk);
+    if (!chunk || !ensureResident(*chunk)) return;
+    if (ref.index >= chunk->instances.size()) return;
+
+    chunk->instances.remove(ref.index);
+    --chunk->instanceCount;
+    --totalInstances;
+    markEdited(*chunk);
+    eraseIfEmpty(ref.chunk);
+}
+
+void ChunkedScene::setSpriteFrame(const InstanceRef& ref, int spriteFrame, sf::Vector2f size) {
+    Chunk* chunk = findChunk(ref.chunk);
+    if (!chunk || !ensureResident(*chunk)) return;
+    if (ref.index >= chunk->instances.size()) return;
+
+    chunk->instances.setSpriteFrame(ref.index, spriteFrame, size);
+    chunk->contentBounds = uniteRect(chunk->contentBounds, chunk->instances.getBounds(ref.index));
+    markEdited(*chunk);
+    maxInstanceSize.x = std::max(maxInstanceSize.x, size.x);
+    maxInstanceSize.y = std::max(maxInstanceSize.y, size.y);
+}
+
+void ChunkedScene::setOverride(const InstanceRef& ref, const std::string& key, const std::string& value) {
+    Chunk* chunk = findChunk(ref.chunk);
+    if (!chunk || !ensureResident(*chunk)) return;
+    if (ref.index >= chunk->instances.size()) return;
+
+    chunk->instances.setOverride(ref.index, key, value);
+    markEdited(*chunk);
+}
+
+InstanceRef ChunkedScene::setPosition(const InstanceRef& ref, sf::Vector2f position) {
+    Chunk* chunk = findChunk(ref.chunk);
+    if (!chunk || !ensureResident(*chunk)) return ref;
+    if (ref.index >= chunk->instances.size()) return ref;
+
+    if (chunkAt(position) == ref.chunk) {
+        chunk->instances.setPosition(ref.index, position);
+        chunk->contentBounds = uniteRect(chunk->contentBounds, chunk->instances.getBounds(ref.index));
+        markEdited(*chunk);
+        return ref;
+    }
+
+    // Mudou de chunk: recria a instância no destino, preservando as sobrescritas.
+    // O destino é lido antes de remover a origem, para a instância não se perder
+    if (!ensureResident(getOrCreateChunk(chunkAt(position)))) {
+        LOG_ERROR("Instância não movida: o chunk de destino não pôde ser lido.");
+        return ref;
+    }
+    PlacedInstance instance = chunk->instances[ref.index];
+    sf::FloatRect bounds = chunk->instances.getBounds(ref.index);
+    std::map<std::string, std::string> overrides;
+    if (const auto* values = chunk->instances.getOverrides(ref.index)) {
+        overrides = *values;
+    }
+
+    remove(ref);
+    InstanceRef moved = add(instance.prototypeId, position, sf::Vector2f(bounds.width, bounds.height), instance.spriteFrame,
+                            instance.sequence);
+    Chunk& target = *findChunk(moved.chunk);
+    for (const auto& entry : overrides) {
+        target.instances.setOverride(moved.index, entry.first, entry.second);
+    }
+    return moved;
+}
+
+void ChunkedScene::clear() {
+    for (auto& entry : chunks) {
+        Chunk& chunk = *entry.second;
+        if (chunk.pendingWrite.valid()) chunk.pendingWrite.wait();
+        if (chunk.pendingLoad.valid()) chunk.pendingLoad.wait();
+        if (chunk.hasFile || chunk.state == ChunkState::PagingOut) {
+            std::error_code ec;
+            fs::remove(chunkFilePath(chunk.coord), ec);
+        }
+    }
+    chunks.clear();
+    totalInstances = 0;
+    nextSequence = 0;
+    ++editCounter;
+    maxInstanceSize = sf::Vector2f(0, 0);
+}
+
+const PlacedInstance* ChunkedScene::get(const InstanceRef& ref) const {
+    Chunk* chunk = findChunk(ref.chunk);
+    if (!chunk || chunk->state != ChunkState::Resident || ref.index >= chunk->instances.size()) {
+        return nullptr;
+    }
+    return &chunk->instances[ref.index];
+}
+
+void ChunkedScene::visitChunksInRect(const sf::FloatRect& rect, const std::function<void(Chunk&)>& visitor) {
+    ChunkCoord first = chunkAt(sf::Vector2f(rect.left, rect.top));
+    ChunkCoord last = chunkAt(sf::Vector2f(rect.left + rect.width, rect.top + rect.height));
+    long long area = static_cast<long long>(last.x - first.x + 1) * (last.y - first.y + 1);
+
+    if (area <= static_cast<long long>(chunks.size())) {
+        for (int y = first.y; y <= last.y; ++y) {
+            for (int x = first.x; x <= last.x; ++x) {
+                if (Chunk* chunk = findChunk(ChunkCoord{x, y})) {
+                    visitor(*chunk);
+                }
+            }
+        }
+        return;
+    }
+
+    // Área maior que o número de chunks: filtra o mapa, na mesma ordem (linha, coluna)
+    std::vector<Chunk*> matches;
+    for (auto& entry : chunks) {
+        const ChunkCoord& coord = entry.first;
+        if (coord.x >= first.x && coord.x <= last.x && coord.y >= first.y && coord.y <= last.y) {
+            matches.push_back(entry.second.get());
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const Chunk* a, const Chunk* b) { return a->coord < b->coord; });
+    for (Chunk* chunk : matches) {
+        visitor(*chunk);
+    }
+}
+
+bool ChunkedScene::findTopmostAt(sf::Vector2f worldPos, InstanceRef& out) {
+    bool found = false;
+    std::vector<std::uint32_t> hits;
+
+    // Chunks desenhados depois ficam por cima, assim como índices maiores no chunk
+    visitChunksInRect(expandForOverhang(sf::FloatRect(worldPos, sf::Vector2f(0, 0))), [&](Chunk& chunk) {
+        if (!ensureResident(chunk)) return;
+        chunk.instances.queryPoint(worldPos, hits);
+        if (!hits.empty()) {
+            out = InstanceRef{chunk.coord, *std::max_element(hits.begin(), hits.end())};
+            found = true;
+        }
+    });
+    return found;
+}
+
+bool ChunkedScene::findAnchoredAt(sf::Vector2f position, InstanceRef& out) {
+    // A instância fica no chunk que contém sua posição
+    ChunkCoord coord = chunkAt(position);
+    Chunk* chunk = findChunk(coord);
+    if (!chunk || !ensureResident(*chunk)) return false;
+
+    std::size_t index;
+    if (!chunk->instances.findAnchoredAt(position, index)) return false;
+    out = InstanceRef{coord, static_cast<std::uint32_t>(index)};
+    return true;
+}
+
+void ChunkedScene::queryRect(const sf::FloatRect& rect, std::vector<InstanceRef>& out) {
+    out.clear();
+    std::vector<std::uint32_t> hits;
+    visitChunksInRect(expandForOverhang(rect), [&](Chunk& chunk) {
+        if (!ensureResident(chunk)) return;
+        chunk.instances.queryRect(rect, hits);
+        for (std::uint32_t index : hits) {
+            out.push_back(InstanceRef{chunk.coord, index});
+        }
+    });
+}
+
+bool ChunkedScene::updateStreaming(const sf::FloatRect& visibleArea) {
+    sf::FloatRect loadArea = expandRect(visibleArea, LoadMarginChunks * chunkWorldSize());
+    sf::FloatRect keepArea = expandRect(visibleArea, KeepMarginChunks * chunkWorldSize());
+
+    bool becameResident = false;
+    pendingChunkCount = 0;
+    for (auto& entry : chunks) {
+        Chunk& chunk = *entry.second;
+        bool wasLoading = chunk.state == ChunkState::Loading;
+        pollPending(chunk);
+        becameResident |= wasLoading && chunk.state == ChunkState::Resident;
+
+        sf::FloatRect area = chunk.hasContent ? uniteRect(chunk.contentBounds, chunkArea(chunk.coord)) : chunkArea(chunk.coord);
+        if (area.intersects(loadArea)) {
+            if (chunk.state == ChunkState::PagedOut || chunk.state == ChunkState::PagingOut) {
+                requestPageIn(chunk);
+            }
+        } else if (!area.intersects(keepArea) && chunk.state == ChunkState::Resident) {
+            requestPageOut(chunk);
+        }
+
+        if (chunk.state == ChunkState::Loading || chunk.state == ChunkState::PagingOut) {
+            ++pendingChunkCount;
+        }
+    }
+    return becameResident;
+}
+
+void ChunkedScene::render(sf::RenderTarget& target, const EntityManager& entityManager, const sf::FloatRect& visibleArea) {
+    drawCallCount = 0;
+    visitChunksInRect(expandForOverhang(visibleArea), [&](Chunk& chunk) {
+        // Chunks ainda carregando aparecem assim que o streaming termina
+        if (chunk.state != ChunkState::Resident || !chunk.hasContent || !chunk.contentBounds.intersects(visibleArea)) {
+            return;
+        }
+        chunk.renderer.render(target, chunk.instances, entityManager, sf::RenderStates::Default, chunk.contentBounds);
+        drawCallCount += chunk.renderer.getDrawCallCount();
+    });
+}
+
+void ChunkedScene::takeSnapshot(std::uint64_t sinceEdit, std::vector<ChunkSnapshot>& out) {
+    out.clear();
+    out.reserve(chunks.size());
+    for (auto& entry : chunks) {
+        Chunk& chunk = *entry.second;
+        ChunkSnapshot snapshot{chunk.coord, chunk.lastEdit, nullptr};
+
+        if (chunk.lastEdit > sinceEdit) {
+            if (chunk.state == ChunkState::Resident) {
+                snapshot.data = chunk.instances.share();
+            } else if (chunk.state == ChunkState::PagingOut) {
+                snapshot.data = chunk.writingStore->share();
+            } else if (chunk.unsnapshottedData) {
+                snapshot.data = chunk.unsnapshottedData;
+            } else if (ensureResident(chunk)) {
+                // Só acontece se um snapshot anterior não chegou a ser gravado
+                snapshot.data = chunk.instances.share();
+            } else {
+                // Sem dados a gravação mantém a cópia anterior do chunk; a marca
+                // nova faz a próxima gravação tentar de novo
+                chunk.lastEdit = ++editCounter;
+                out.push_back(std::move(snapshot));
+                continue;
+            }
+        }
+        chunk.unsnapshottedData.reset();
+        out.push_back(std::move(snapshot));
+    }
+
+    std::sort(out.begin(), out.end(), [](const ChunkSnapshot& a, const ChunkSnapshot& b) { return a.coord < b.coord; });
+    lastSnapshotEdit = editCounter;
+}
+
+bool ChunkedScene::forEachInstance(const std::function<void(const PlacedInstance&)>& visitor) {
+    return forEachChunk([&](const ChunkCoord&, const InstanceStore& store) {
+        for (const auto& instance : store) {
+            visitor(instance);
+        }
+    });
+}
+
+bool ChunkedScene::forEachChunk(const std::function<void(const ChunkCoord&, const InstanceStore&)>& visitor) {
+    bool complete = true;
+    std::vector<ChunkCoord> coords;
+    coords.reserve(chunks.size());
+    for (const auto& entry : chunks) {
+        coords.push_back(entry.first);
+    }
+    std::sort(coords.begin(), coords.end());
+
+    for (const ChunkCoord& coord : coords) {
+        Chunk& chunk = *chunks[coord];
+        if (chunk.state == ChunkState::Loading) {
+            chunk.pendingLoad.wait();
+            pollPending(chunk);
+        } else if (chunk.state == ChunkState::PagingOut) {
+            chunk.pendingWrite.wait();
+            finishWrite(chunk);
+        }
+
+        if (chunk.state == ChunkState::Resident) {
+            visitor(coord, chunk.instances);
+            continue;
+        }
+
+        // Lê o chunk descarregado só para esta passagem, sem mantê-lo residente
+        InstanceStore store;
+        store.setCellSize(cellSize);
+        std::ifstream in(chunkFilePath(coord), std::ios::binary);
+        if (!in || !store.readFrom(in)) {
+            LOG_ERROR("Falha ao ler chunk de " << chunkFilePath(coord));
+            complete = false;
+            continue;
+        }
+        visitor(coord, store);
+    }
+    return complete;
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include "EntityManager.hpp"
+#include "InstanceStore.hpp"
+#include "SceneRenderer.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ChunkCoord {
+    int x;
+    int y;
+
+    bool operator==(const ChunkCoord& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const ChunkCoord& other) const { return !(*this == other); }
+    bool operator<(const ChunkCoord& other) const { return y != other.y ? y < other.y : x < other.x; }
+};
+
+struct ChunkCoordHash {
+    std::size_t operator()(const ChunkCoord& coord) const {
+        return std::hash<std::uint64_t>()((static_cast<std::uint64_t>(static_cast<std::uint32_t>(coord.x)) << 32) |
+                                          static_cast<std::uint32_t>(coord.y));
+    }
+};
+
+// Referência a uma instância: chunk + índice no InstanceStore do chunk.
+// Válida apenas até a próxima alteração do chunk.
+struct InstanceRef {
+    ChunkCoord chunk;
+    std::uint32_t index;
+};
+
+// Índice de add() quando o chunk de destino não pôde ser lido do disco
+constexpr std::uint32_t InvalidInstanceIndex = static_cast<std::uint32_t>(-1);
+
+// Estado de um chunk capturado para gravação em segundo plano.
+// `data` é compartilhado com o InstanceStore do chunk (copy-on-write).
+struct ChunkSnapshot {
+    ChunkCoord coord;
+    std::uint64_t lastEdit;                    // Marca da última alteração do chunk
+    std::shared_ptr<const InstanceData> data;  // Nulo se o chunk não mudou desde a marca pedida
+};
+
+// Cena particionada em chunks de ChunkCells x ChunkCells células da grade.
+// Cada chunk tem seu próprio InstanceStore (com índice espacial) e seu próprio
+// SceneRenderer com os lotes em cache. Chunks longe da câmera são gravados em
+// arquivos temporários e liberados da memória; ao se aproximarem, são lidos de
+// volta em segundo plano.
+class ChunkedScene {
+public:
+    static constexpr int ChunkCells = 16;
+
+    ChunkedScene();
+    ~ChunkedScene();
+
+    ChunkedScene(const ChunkedScene&) = delete;
+    ChunkedScene& operator=(const ChunkedScene&) = delete;
+
+    void setCellSize(float size);
+    void setOverlayTexture(const sf::Texture* texture);
+
+    enum class PlaceResult { Added, Replaced, Unchanged, Failed };
+
+    InstanceRef add(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame);
+    // Com a ordem de inserção já conhecida (leitura de arquivo, instância movida ou substituída)
+    InstanceRef add(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame,
+                    std::uint32_t sequence);
+    // Pintura: substitui a instância do topo ancorada em `position`, ou não faz
+    // nada se ela já for o mesmo protótipo e quadro. Sem custo proporcional à cena.
+    // Failed se o chunk está descarregado e o arquivo dele não pôde ser lido
+    PlaceResult place(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame,
+                      InstanceRef* placed = nullptr);
+    void remove(const InstanceRef& ref);
+    void setSpriteFrame(const InstanceRef& ref, int spriteFrame, sf::Vector2f size);
+    InstanceRef setPosition(const InstanceRef& ref, sf::Vector2f position);
+    void setOverride(const InstanceRef& ref, const std::string& key, const std::string& value);
+    void clear();
+
+    const PlacedInstance* get(const InstanceRef& ref) const;
+    bool findTopmostAt(sf::Vector2f worldPos, InstanceRef& out);
+    // Instância do topo cuja posição é exatamente `position` (ver InstanceStore::findAnchoredAt)
+    bool findAnchoredAt(sf::Vector2f position, InstanceRef& out);
+    void queryRect(const sf::FloatRect& rect, std::vector<InstanceRef>& out);
+
+    std::size_t size() const { return totalInstances; }
+    bool empty() const { return totalInstances == 0; }
+    std::size_t getChunkCount() const { return chunks.size(); }
+    std::size_t getResidentChunkCount() const;
+
+    // Carrega chunks próximos à área visível e descarrega os distantes.
+    // Retorna true se algum chunk terminou de carregar (há o que redesenhar)
+    bool updateStreaming(const sf::FloatRect& visibleArea);
+    // Leituras ou gravações de chunks ainda em andamento (na última updateStreaming)
+    bool hasPendingIO() const { return pendingChunkCount > 0; }
+    void render(sf::RenderTarget& target, const EntityManager& entityManager, const sf::FloatRect& visibleArea);
+    std::size_t getDrawCallCount() const { return drawCallCount; }
+
+    // Percorre todas as instâncias (inclusive as de chunks descarregados) em
+    // ordem determinística: chunks por linha e coluna, instâncias na ordem do
+    // chunk. Essa não é a ordem de inserção; para ela, ordenar por PlacedInstance::sequence.
+    // false se algum chunk descarregado não pôde ser lido (a passagem fica incompleta)
+    bool forEachInstance(const std::function<void(const PlacedInstance&)>& visitor);
+    // Cresce a cada alteração da cena
+    std::uint64_t getEditStamp() const { return editCounter; }
+    // Todos os chunks, em ordem, sem copiar instâncias. Só os alterados depois
+    // de sinceEdit trazem os dados; os demais só informam a existência do chunk
+    void takeSnapshot(std::uint64_t sinceEdit, std::vector<ChunkSnapshot>& out);
+
+    // Mesma ordem, um chunk por vez (com acesso às sobrescritas de cada instância)
+    bool forEachChunk(const std::function<void(const ChunkCoord&, const InstanceStore&)>& visitor);
+
+private:
+    enum class ChunkState { Resident, Loading, PagingOut, PagedOut };
+
+    struct Chunk {
+        ChunkCoord coord;
+        ChunkState state = ChunkState::Resident;
+        InstanceStore instances;
+        SceneRenderer renderer;
+
+        std::size_t instanceCount = 0;   // Válido mesmo com o chunk descarregado
+        sf::FloatRect contentBounds;     // União dos retângulos das instâncias
+        bool hasContent = false;
+        bool modified = true;            // Alterado desde a última gravação
+        bool hasFile = false;
+        bool readFailed = false;         // A última leitura do arquivo falhou; tenta de novo
+        std::uint64_t lastEdit = 0;      // editCounter da última alteração
+
+        // Dados de um chunk descarregado ainda não capturados por takeSnapshot
+        std::shared_ptr<const InstanceData> unsnapshottedData;
+
+        std::shared_ptr<InstanceStore> writingStore;
+        std::future<bool> pendingWrite;
+        std::future<std::unique_ptr<InstanceStore>> pendingLoad;
+    };
+
+    ChunkCoord chunkAt(sf::Vector2f worldPos) const;
+    float chunkWorldSize() const { return cellSize * ChunkCells; }
+    sf::FloatRect chunkArea(const ChunkCoord& coord) const;
+    std::string chunkFilePath(const ChunkCoord& coord) const;
+
+    Chunk& getOrCreateChunk(const ChunkCoord& coord);
+    Chunk* findChunk(const ChunkCoord& coord) const;
+    // false se o chunk continua descarregado (a leitura falhou; o arquivo é mantido)
+    bool ensureResident(Chunk& chunk);
+    void requestPageIn(Chunk& chunk);
+    void requestPageOut(Chunk& chunk);
+    void pollPending(Chunk& chunk);
+    void finishWrite(Chunk& chunk);
+    void markEdited(Chunk& chunk) { chunk.modified = true; chunk.lastEdit = ++editCounter; }
+    void eraseIfEmpty(const ChunkCoord& coord);
+    void visitChunksInRect(const sf::FloatRect& rect, const std::function<void(Chunk&)>& visitor);
+    sf::FloatRect expandForOverhang(const sf::FloatRect& rect) const;
+
+    float cellSize = 32.0f;
+    const sf::Texture* overlayTexture = nullptr;
+    std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoordHash> chunks;
+    std::size_t totalInstances = 0;
+    std::uint64_t editCounter = 0;
+    std::uint64_t lastSnapshotEdit = 0;
+    std::uint32_t nextSequence = 0;  // PlacedInstance::sequence da próxima instância nova
+    sf::Vector2f maxInstanceSize;  // Maior instância, para achar as que invadem chunks vizinhos
+    std::string storageDirectory;
+    std::size_t drawCallCount = 0;
+    std::size_t pendingChunkCount = 0;
+};
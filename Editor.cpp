@@ -1,5 +1,8 @@
 #include "Editor.hpp"
-#include <iostream>
+#include "SceneExporter.hpp"
+#include "BinaryScene.hpp"
+#include "SceneImporter.hpp"
+#include "Log.hpp"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -10,21 +13,27 @@
 #include <stdexcept>
 #include <string>
 #include <array>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
 
 namespace fs = std::filesystem;
 
+const sf::Time Editor::BackgroundPollInterval = sf::milliseconds(16);
+const sf::Time Editor::EventPumpInterval = sf::milliseconds(10);
 Editor::Editor() : gridSize(32), selectedEntity(nullptr), selectedTileIndex(-1), isFloatingWindowOpen(false), selectedEntityIndex(-1), selectedEntityPath(""), selectedNodeIndex(-1) {
     window.create(sf::VideoMode(1024, 768), "Editor de Entidades");
-    entityManager.loadEntitiesFromDirectory("entities");
-    
-    if (entityManager.getEntities().empty()) {
-        std::cerr << "Nenhuma entidade carregada. Verifique o diretório de entidades." << std::endl;
-    }
+    window.setFramerateLimit(DefaultFrameRateLimit);
+    // As entidades chegam aos poucos; veja update()
+    entityManager.beginLoadingFromDirectory("entities");
     
     rootNode.name = "entities";
     rootNode.isDirectory = true;
     rootNode.isOpen = true;
+    rootNode.path = "entities";
     loadFileStructure("entities", rootNode);
+    collectEntityPaths(rootNode, entityIndex);
+    appendVisibleRows(rootNode, 0, sidebarRows);
     
     editArea.setSize(sf::Vector2f(700, 768));
     editArea.setPosition(324, 0);
@@ -33,20 +42,28 @@ Editor::Editor() : gridSize(32), selectedEntity(nullptr), selectedTileIndex(-1),
     sidebarArea.setSize(sf::Vector2f(324, 768));
     sidebarArea.setPosition(0, 0);
     sidebarArea.setFillColor(sf::Color(220, 220, 220));
-    
-    createGrid();
-    
-    if (!font.loadFromFile("/System/Library/Fonts/Helvetica.ttc")) {
-        std::cerr << "Falha ao carregar a fonte" << std::endl;
+
+    if (!sidebarCache.create(sidebarArea.getSize().x, sidebarArea.getSize().y) ||
+        !floatingWindowCache.create(FloatingWindowWidth, FloatingWindowHeight)) {
+        LOG_ERROR("Falha ao criar as texturas dos painéis");
     }
+
+    camera.setScreenArea(editArea.getGlobalBounds(), window.getSize());
+    
+    scene.setCellSize(gridSize);
+
+    // Ícones e fonte da interface: carregados só aqui, nunca durante o desenho
+    resources.load();
+    scene.setOverlayTexture(resources.getIcon(EditorResources::Icon::Invisible));
 }
 
 void Editor::loadFileStructure(const std::string& path, FileNode& node) {
-    std::cout << "Carregando estrutura de arquivos para: " << path << std::endl;
+    LOG_DEBUG("Carregando estrutura de arquivos para: " << path);
     for (const auto& entry : fs::directory_iterator(path)) {
         if (entry.is_directory() || (entry.path().extension() == ".ent")) {
             FileNode childNode;
             childNode.name = entry.path().filename().string();
+            childNode.path = entry.path().generic_string();
             childNode.isDirectory = entry.is_directory();
             childNode.isOpen = false;
             
@@ -55,18 +72,14 @@ void Editor::loadFileStructure(const std::string& path, FileNode& node) {
             }
             
             node.children.push_back(childNode);
-            std::cout << "Adicionado: " << childNode.name << (childNode.isDirectory ? " (diretório)" : " (arquivo)") << std::endl;
+            LOG_DEBUG("Adicionado: " << childNode.name << (childNode.isDirectory ? " (diretório)" : " (arquivo)"));
         }
     }
 }
 
 void Editor::createMenu() {
-    if (!menuFont.loadFromFile("/System/Library/Fonts/Helvetica.ttc")) {
-        std::cerr << "Falha ao carregar a fonte do menu" << std::endl;
-    }
-
     sf::Text fileMenu;
-    fileMenu.setFont(menuFont);
+    fileMenu.setFont(resources.getFont());
     fileMenu.setString("File");
     fileMenu.setCharacterSize(20);
     fileMenu.setFillColor(sf::Color::Black);
@@ -76,26 +89,26 @@ void Editor::createMenu() {
     isMenuOpen = false;
 }
 
-void Editor::handleMenu() {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-        for (const auto& menuItem : menuItems) {
-            if (menuItem.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-                if (menuItem.getString() == "File") {
-                    isMenuOpen = !isMenuOpen;
-                }
+bool Editor::handleMenuClick(sf::Vector2i mousePos) {
+    for (const auto& menuItem : menuItems) {
+        if (menuItem.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
+            if (menuItem.getString() == "File") {
+                isMenuOpen = !isMenuOpen;
+                invalidate(DirtyMenu);
             }
+            return true;
         }
+    }
 
-        if (isMenuOpen) {
-            sf::FloatRect menuBounds = menuItems[0].getGlobalBounds();
-            sf::Vector2f savePos(menuBounds.left, menuBounds.top + menuBounds.height);
-            if (sf::FloatRect(savePos.x, savePos.y, 100, 30).contains(mousePos.x, mousePos.y)) {
-                showSaveFileDialog();
-            }
+    if (isMenuOpen) {
+        sf::FloatRect menuBounds = menuItems[0].getGlobalBounds();
+        sf::Vector2f savePos(menuBounds.left, menuBounds.top + menuBounds.height);
+        if (sf::FloatRect(savePos.x, savePos.y, 100, 30).contains(mousePos.x, mousePos.y)) {
+            showSaveFileDialog();
+            return true;
         }
     }
+    return false;
 }
 
 void Editor::showSaveFileDialog() {
@@ -104,7 +117,7 @@ void Editor::showSaveFileDialog() {
     
     FILE* pipe = popen(command.c_str(), "r");
     if (!pipe) {
-        std::cerr << "Erro ao abrir o diálogo de salvamento" << std::endl;
+        LOG_ERROR("Erro ao abrir o diálogo de salvamento");
         return;
     }
     
@@ -115,6 +128,8 @@ void Editor::showSaveFileDialog() {
             result += buffer;
     }
     pclose(pipe);
+    // O diálogo pode ter coberto a janela
+    invalidate(DirtyAll);
     
     // Remove a nova linha no final do caminho do arquivo
     if (!result.empty() && result[result.length()-1] == '\n') {
@@ -123,334 +138,493 @@ void Editor::showSaveFileDialog() {
     
     if (!result.empty()) {
         saveFilePath = result;
-        exportScene(saveFilePath);
+        if (fs::path(saveFilePath).extension() == ".escb") {
+            saveScene(saveFilePath);
+        } else {
+            exportScene(saveFilePath);
+        }
+    }
+}
+
+void Editor::showOpenFileDialog() {
+    std::string command = "osascript -e 'tell application \"System Events\" to activate' -e 'tell application \"System Events\" to set filePath to choose file with prompt \"Open Scene:\"' -e 'return POSIX path of filePath'";
+
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        LOG_ERROR("Erro ao abrir o diálogo de abertura");
+        return;
+    }
+
+    char buffer[256];
+    std::string result = "";
+    while (fgets(buffer, 256, pipe) != NULL) {
+        result += buffer;
+    }
+    pclose(pipe);
+    invalidate(DirtyAll);
+
+    if (!result.empty() && result[result.length()-1] == '\n') {
+        result.erase(result.length()-1);
+    }
+
+    if (!result.empty()) {
+        loadScene(result);
     }
 }
 
 void Editor::renderSidebar() {
-    const float padding = 10.0f;
-    float yOffset = padding;
-    int currentIndex = 0;
-    renderFileNode(rootNode, 0, yOffset, currentIndex);
+    sidebarCache.clear(sidebarArea.getFillColor());
+
+    // Só as linhas dentro da área visível da barra lateral
+    const float viewHeight = sidebarArea.getSize().y;
+    std::size_t first = 0;
+    if (sidebarScroll > SidebarPadding) {
+        first = static_cast<std::size_t>((sidebarScroll - SidebarPadding) / SidebarLineHeight);
+    }
+    for (std::size_t row = first; row < sidebarRows.size(); ++row) {
+        float y = SidebarPadding + row * SidebarLineHeight - sidebarScroll;
+        if (y >= viewHeight) break;
+        renderSidebarRow(sidebarRows[row], y);
+    }
+
+    if (entityManager.isLoading()) {
+        sf::Text progressText("Carregando entidades: " + std::to_string(entityManager.getFinishedCount()) +
+                              "/" + std::to_string(entityManager.getQueuedCount()), resources.getFont(), 12);
+        progressText.setPosition(SidebarPadding, viewHeight - 24);
+        progressText.setFillColor(sf::Color(80, 80, 80));
+        sidebarCache.draw(progressText);
+    }
+
+    sidebarCache.display();
 }
 
-void Editor::renderFileNode(const FileNode& node, int depth, float& yOffset, int& currentIndex) {
-    const float indentSize = 20.0f;
-    const float lineHeight = 20.0f;
-    const float xPos = 10.0f + depth * indentSize;
+void Editor::renderSidebarRow(const SidebarRow& row, float y) {
+    const FileNode& node = *row.node;
+    const float xPos = SidebarPadding + row.depth * SidebarIndent;
 
-    sf::Text text(node.name, font, 12);
-    text.setPosition(xPos, yOffset);
+    sf::Text text(node.name, resources.getFont(), 12);
+    text.setPosition(xPos, y);
     text.setFillColor(sf::Color::Black);
 
+    // Arquivos ainda não carregados aparecem em cinza
+    if (!node.isDirectory && entityManager.isLoading() && !entityManager.getEntityByPath(node.path)) {
+        text.setFillColor(sf::Color(150, 150, 150));
+    }
+
     if (node.isDirectory) {
         text.setString((node.isOpen ? "- " : "+ ") + node.name);
     }
 
     // Highlight para nós selecionados (diretórios e arquivos)
-    bool isSelected = (!node.isDirectory && currentIndex == selectedNodeIndex) || 
-                      (selectedEntityPath == getFullPath(node));
-    
+    bool isSelected = (!node.isDirectory && node.entityIndex == selectedNodeIndex) ||
+                      (selectedEntityPath == node.path);
+
     if (isSelected) {
-        sf::RectangleShape highlight(sf::Vector2f(sidebarArea.getSize().x - xPos, lineHeight));
-        highlight.setPosition(xPos, yOffset);
+        sf::RectangleShape highlight(sf::Vector2f(sidebarArea.getSize().x - xPos, SidebarLineHeight));
+        highlight.setPosition(xPos, y);
         highlight.setFillColor(sf::Color(200, 200, 255, 100));
-        window.draw(highlight);
+        sidebarCache.draw(highlight);
     }
 
-    window.draw(text);
+    sidebarCache.draw(text);
+}
 
-    yOffset += lineHeight;
+void Editor::appendVisibleRows(FileNode& node, int depth, std::vector<SidebarRow>& rows) {
+    rows.push_back({&node, depth});
+    if (node.isDirectory && node.isOpen) {
+        for (auto& child : node.children) {
+            appendVisibleRows(child, depth + 1, rows);
+        }
+    }
+}
 
-    if (!node.isDirectory) {
-        currentIndex++;
+void Editor::toggleDirectoryRow(std::size_t row) {
+    FileNode& node = *sidebarRows[row].node;
+    const int depth = sidebarRows[row].depth;
+    node.isOpen = !node.isOpen;
+
+    // Só as linhas do próprio diretório entram ou saem da lista
+    if (node.isOpen) {
+        std::vector<SidebarRow> children;
+        for (auto& child : node.children) {
+            appendVisibleRows(child, depth + 1, children);
+        }
+        sidebarRows.insert(sidebarRows.begin() + row + 1, children.begin(), children.end());
+    } else {
+        std::size_t end = row + 1;
+        while (end < sidebarRows.size() && sidebarRows[end].depth > depth) {
+            ++end;
+        }
+        sidebarRows.erase(sidebarRows.begin() + row + 1, sidebarRows.begin() + end);
     }
 
-    if (node.isDirectory && node.isOpen) {
-        for (const auto& child : node.children) {
-            renderFileNode(child, depth + 1, yOffset, currentIndex);
+    scrollSidebar(0);
+    invalidate(DirtySidebar);
+}
+
+int Editor::sidebarRowAt(float y) const {
+    float offset = y + sidebarScroll - SidebarPadding;
+    if (offset < 0) return -1;
+    std::size_t row = static_cast<std::size_t>(offset / SidebarLineHeight);
+    return row < sidebarRows.size() ? static_cast<int>(row) : -1;
+}
+
+void Editor::scrollSidebar(float delta) {
+    float contentHeight = SidebarPadding * 2 + sidebarRows.size() * SidebarLineHeight;
+    float maxScroll = std::max(0.0f, contentHeight - sidebarArea.getSize().y);
+    float scroll = std::clamp(sidebarScroll + delta, 0.0f, maxScroll);
+    if (scroll != sidebarScroll) {
+        sidebarScroll = scroll;
+        invalidate(DirtySidebar);
+    }
+}
+
+void Editor::scrollToEntity(int index) {
+    for (std::size_t row = 0; row < sidebarRows.size(); ++row) {
+        if (sidebarRows[row].node->entityIndex != index) continue;
+
+        // Diretório fechado: a entrada não tem linha e a rolagem não muda
+        float top = SidebarPadding + row * SidebarLineHeight;
+        if (top < sidebarScroll) {
+            scrollSidebar(top - sidebarScroll);
+        } else if (top + SidebarLineHeight > sidebarScroll + sidebarArea.getSize().y) {
+            scrollSidebar(top + SidebarLineHeight - sidebarScroll - sidebarArea.getSize().y);
         }
+        return;
     }
 }
 
 void Editor::handleMouseClick(sf::Vector2i mousePos) {
     if (sidebarArea.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-        float yOffset = 10.0f;
-        int currentIndex = 0;
-        std::string clickedPath = getClickedEntityPath(mousePos.x, mousePos.y, yOffset, currentIndex);
-        std::cout << "Caminho clicado: " << clickedPath << std::endl;
-        if (!clickedPath.empty()) {
-            selectedNodeIndex = currentIndex - 1; // Atualize o índice selecionado
-            selectEntity(clickedPath);
-            showEntityDetails();
+        int row = sidebarRowAt(mousePos.y - sidebarArea.getPosition().y);
+        if (row < 0) return;
+
+        const FileNode& node = *sidebarRows[row].node;
+        if (node.isDirectory) {
+            toggleDirectoryRow(row);
+            return;
         }
+
+        LOG_DEBUG("Caminho clicado: " << node.path);
+        selectedNodeIndex = node.entityIndex;
+        selectEntity(node.path);
+        showEntityDetails();
     } else if (isFloatingWindowOpen) {
-        sf::FloatRect windowBounds(floatingWindowPosition, sf::Vector2f(400, 500));
+        sf::FloatRect windowBounds(floatingWindowPosition, sf::Vector2f(FloatingWindowWidth, FloatingWindowHeight));
         if (windowBounds.contains(mousePos.x, mousePos.y)) {
             handleFloatingWindowClick(sf::Vector2f(mousePos) - floatingWindowPosition);
         } else if (editArea.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-            if (selectedEntity && selectedTileIndex >= 0) {
-                std::cout << "Tentando colocar entidade na posição: (" << mousePos.x << ", " << mousePos.y << ")" << std::endl;
-                placeEntity(mousePos);
-            }
+            handleEditAreaClick(mousePos);
         }
     } else if (editArea.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-        if (selectedEntity && selectedTileIndex >= 0) {
-            std::cout << "Tentando colocar entidade na posição: (" << mousePos.x << ", " << mousePos.y << ")" << std::endl;
-            placeEntity(mousePos);
-        }
+        handleEditAreaClick(mousePos);
     }
 }
 
-std::string Editor::getFullPath(const FileNode& node) {
-    std::string path = "entities/";
-    path += node.name;
-    return path;
+void Editor::handleEditAreaClick(sf::Vector2i mousePos) {
+    // Alt + clique copia a entidade e o frame da instância sob o cursor
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt) || sf::Keyboard::isKeyPressed(sf::Keyboard::RAlt)) {
+        pickEntityAt(mousePos);
+        return;
+    }
+
+    if (selectedEntity && selectedTileIndex >= 0) {
+        LOG_DEBUG("Tentando colocar entidade na posição: (" << mousePos.x << ", " << mousePos.y << ")");
+        placeEntity(mousePos);
+    }
 }
 
-std::string Editor::getClickedEntityPath(float x, float y, float& yOffset, int& outIndex) {
-    outIndex = 0;
-    return getClickedEntityPathRecursive(rootNode, 0, x, y, yOffset, outIndex);
+bool Editor::findInstanceAt(sf::Vector2i mousePos, InstanceRef& out) {
+    return scene.findTopmostAt(camera.screenToWorld(mousePos), out);
 }
 
-std::string Editor::getClickedEntityPathRecursive(const FileNode& node, int depth, float x, float y, float& yOffset, int& currentIndex) {
-    const float indentSize = 20.0f;
-    const float lineHeight = 20.0f;
-    const float xPos = 10.0f + depth * indentSize;
+void Editor::eraseEntityAt(sf::Vector2i mousePos) {
+    if (!editArea.getGlobalBounds().contains(mousePos.x, mousePos.y)) return;
 
-    if (y >= yOffset && y < yOffset + lineHeight) {
-        if (!node.isDirectory) {
-            currentIndex++;
-            return getFullPath(node);
-        }
-    }
+    InstanceRef instance;
+    if (!findInstanceAt(mousePos, instance)) return;
 
-    yOffset += lineHeight;
+    scene.remove(instance);
+    invalidate(DirtyCanvas);
+    LOG_DEBUG("Entidade removida. Total de entidades colocadas: " << scene.size());
+}
 
-    if (node.isDirectory && node.isOpen) {
-        for (const auto& child : node.children) {
-            std::string result = getClickedEntityPathRecursive(child, depth + 1, x, y, yOffset, currentIndex);
-            if (!result.empty()) {
-                return result;
-            }
-        }
-    }
+void Editor::pickEntityAt(sf::Vector2i mousePos) {
+    InstanceRef ref;
+    if (!findInstanceAt(mousePos, ref)) return;
 
-    if (!node.isDirectory) {
-        currentIndex++;
-    }
+    const PlacedInstance* instance = scene.get(ref);
+    if (!instance) return;
+    const Entity* entity = entityManager.getEntityById(instance->prototypeId);
+    if (!entity) return;
 
-    return "";
+    int spriteFrame = instance->spriteFrame;
+    selectEntity(entity->getName());
+    selectedTileIndex = spriteFrame;
+    invalidate(DirtyFloatingWindow | DirtyCanvas);
 }
 
 void Editor::showEntityDetails() {
     if (selectedEntity) {
         isFloatingWindowOpen = true;
         floatingWindowPosition = sf::Vector2f(324, 0);
-        std::cout << "Mostrando detalhes da entidade: " << selectedEntity->getName() << std::endl;
+        LOG_DEBUG("Mostrando detalhes da entidade: " << selectedEntity->getName());
     } else {
-        std::cout << "Nenhuma entidade selecionada para mostrar detalhes." << std::endl;
-    }
-}
-
-void Editor::toggleNodeOpen(FileNode& node) {
-    if (node.isDirectory) {
-        node.isOpen = !node.isOpen;
+        LOG_DEBUG("Nenhuma entidade selecionada para mostrar detalhes.");
     }
 }
 
 void Editor::exportScene(const std::string& filename) {
-    tinyxml2::XMLDocument doc;
-    
-    tinyxml2::XMLDeclaration* decl = doc.NewDeclaration();
-    doc.InsertFirstChild(decl);
-
-    tinyxml2::XMLElement* root = doc.NewElement("Ethanon");
-    doc.InsertEndChild(root);
-
-    // Scene Properties
-    tinyxml2::XMLElement* sceneProps = doc.NewElement("SceneProperties");
-    sceneProps->SetAttribute("lightIntensity", "2");
-    sceneProps->SetAttribute("parallaxIntensity", "0");
-    root->InsertEndChild(sceneProps);
-
-    tinyxml2::XMLElement* ambient = doc.NewElement("Ambient");
-    ambient->SetAttribute("r", "1");
-    ambient->SetAttribute("g", "1");
-    ambient->SetAttribute("b", "1");
-    sceneProps->InsertEndChild(ambient);
-
-    tinyxml2::XMLElement* zAxis = doc.NewElement("ZAxisDirection");
-    zAxis->SetAttribute("x", "0");
-    zAxis->SetAttribute("y", "-1");
-    sceneProps->InsertEndChild(zAxis);
-
-    // Entities in Scene
-    tinyxml2::XMLElement* entitiesInScene = doc.NewElement("EntitiesInScene");
-    root->InsertEndChild(entitiesInScene);
-
-    int entityId = 1;
-    for (const auto& entity : placedEntities) {
-        tinyxml2::XMLElement* entityElement = doc.NewElement("Entity");
-        entityElement->SetAttribute("id", entityId++);
-        entityElement->SetAttribute("spriteFrame", entity->getSelectedTileIndex());
-        entitiesInScene->InsertEndChild(entityElement);
-
-        // Extrair apenas o nome do arquivo da entidade
-        std::string entityFileName = entity->getName();
-        size_t lastSlash = entityFileName.find_last_of("/\\");
-        if (lastSlash != std::string::npos) {
-            entityFileName = entityFileName.substr(lastSlash + 1);
-        }
-
-        tinyxml2::XMLElement* entityNameElement = doc.NewElement("EntityName");
-        entityNameElement->SetText(entityFileName.c_str());
-        entityElement->InsertEndChild(entityNameElement);
-
-        tinyxml2::XMLElement* position = doc.NewElement("Position");
-        sf::Vector2f entityPos = entity->getPosition();
-        position->SetAttribute("x", static_cast<int>(entityPos.x));
-        position->SetAttribute("y", static_cast<int>(entityPos.y));
-        position->SetAttribute("z", 0);
-        position->SetAttribute("angle", 0);
-        entityElement->InsertEndChild(position);
-
-        tinyxml2::XMLElement* entityDetails = doc.NewElement("Entity");
-        entityElement->InsertEndChild(entityDetails);
-
-        tinyxml2::XMLElement* fileName = doc.NewElement("FileName");
-        fileName->SetText(entityFileName.c_str());
-        entityDetails->InsertEndChild(fileName);
-
-        // Adicionar CustomData
-        tinyxml2::XMLElement* customData = doc.NewElement("CustomData");
-        entityDetails->InsertEndChild(customData);
-
-        // Adicionar variáveis de CustomData
-        addCustomDataVariable(doc, customData, "uint", "allowDecals", "1");
-        addCustomDataVariable(doc, customData, "string", "material", "stone");
-    }
-
-    // Salvar o documento XML
-    tinyxml2::XMLError result = doc.SaveFile(filename.c_str());
-    if (result == tinyxml2::XML_SUCCESS) {
-        std::cout << "Cena exportada com sucesso para " << filename << std::endl;
+    SceneExporter exporter;
+    if (exporter.exportEsc(filename, scene, entityManager)) {
+        LOG_INFO("Cena exportada com sucesso para " << filename);
     } else {
-        std::cerr << "Erro ao exportar a cena para " << filename << std::endl;
+        LOG_ERROR("Erro ao exportar a cena para " << filename);
     }
 }
 
 void Editor::renderPlacedEntities() {
-    for (const auto& entity : placedEntities) {
-        sf::Vector2f pos = entity->getPosition();
-        pos.x += editArea.getPosition().x;
-        pos.y += editArea.getPosition().y;
-        
-        if (entity->hasSprite()) {
-            sf::Sprite sprite = entity->getSprite();
-            sprite.setPosition(pos);
-            window.draw(sprite);
-        } else {
-            renderInvisibleEntity(window, entity.get());
-        }
-    }
+    // Um draw por textura + sobreposição das invisíveis, só com o que está na câmera
+    scene.render(window, entityManager, camera.getVisibleArea());
 }
 
-// Função auxiliar para adicionar variáveis de CustomData
-void Editor::addCustomDataVariable(tinyxml2::XMLDocument& doc, tinyxml2::XMLElement* customData, 
-                                   const std::string& type, const std::string& name, const std::string& value) {
-    tinyxml2::XMLElement* variable = doc.NewElement("Variable");
-    customData->InsertEndChild(variable);
-
-    tinyxml2::XMLElement* typeElement = doc.NewElement("Type");
-    typeElement->SetText(type.c_str());
-    variable->InsertEndChild(typeElement);
-
-    tinyxml2::XMLElement* nameElement = doc.NewElement("Name");
-    nameElement->SetText(name.c_str());
-    variable->InsertEndChild(nameElement);
-
-    tinyxml2::XMLElement* valueElement = doc.NewElement("Value");
-    valueElement->SetText(value.c_str());
-    variable->InsertEndChild(valueElement);
-}
-
-void Editor::selectEntity(const std::string& path) {
+void Editor::selectEntity(const std::string& path, bool waitForTexture) {
     Entity* entity = entityManager.getEntityByPath(path);
     if (entity) {
         selectedEntity = entity;
+        selectedPrototypeId = entityManager.getEntityIdByPath(path);
+        if (waitForTexture || entityManager.isTextureResident(selectedPrototypeId)) {
+            selectedTexture = entity->acquireTexture();
+            selectedTexturePending = false;
+        } else {
+            // A textura chega por processPrefetchedTextures; veja update()
+            selectedTexture.reset();
+            selectedTexturePending = true;
+            entityManager.prefetchTexture(selectedPrototypeId);
+        }
         updateGridSize();
         selectedEntityPath = path;
         selectedTileIndex = 0;
         isFloatingWindowOpen = true;
         floatingWindowPosition = sf::Vector2f(324, 0);
         createTileThumbnails();
-        std::cout << "Entidade selecionada: " << path << std::endl;
+        invalidate(DirtySidebar | DirtyFloatingWindow | DirtyCanvas);
+        LOG_DEBUG("Entidade selecionada: " << path);
     } else {
-        std::cout << "Entidade não encontrada: " << path << std::endl;
+        LOG_WARNING("Entidade não encontrada: " << path);
+    }
+}
+
+void Editor::setFrameRateLimit(unsigned limit) {
+    window.setFramerateLimit(limit);
+}
+
+bool Editor::hasBackgroundWork() const {
+    // Alterações ainda não gravadas não contam: run() só acorda no prazo da gravação automática
+    return entityManager.isLoading() || entityManager.hasPendingPrefetches() || scene.hasPendingIO() ||
+           autosave.isSaving();
+}
+
+bool Editor::waitEventFor(sf::Event& event, sf::Time timeout) {
+    sf::Clock clock;
+    while (!window.pollEvent(event)) {
+        sf::Time remaining = timeout - clock.getElapsedTime();
+        if (remaining <= sf::Time::Zero) {
+            return false;
+        }
+        sf::sleep(std::min(remaining, EventPumpInterval));
     }
+    return true;
 }
 
 void Editor::run() {
     createMenu();
     while (window.isOpen()) {
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        updateEntityPreview(mousePos);
-        
-        handleEvents();
-        handleMenu();
-        update();
-        render();
+        if (dirtyRegions == DirtyNone) {
+            if (hasBackgroundWork()) {
+                // Só há trabalho em segundo plano: verifica de tempos em tempos sem ocupar a CPU
+                sf::sleep(BackgroundPollInterval);
+            } else if (autosave.hasUnsavedEdits(scene)) {
+                // Só a gravação automática pendente: dorme até um evento ou o prazo dela
+                sf::Event event;
+                if (waitEventFor(event, autosave.getTimeUntilDue())) {
+                    handleEvent(event);
+                }
+            } else {
+                // Nada mudando: dorme até o próximo evento
+                sf::Event event;
+                if (window.waitEvent(event)) {
+                    handleEvent(event);
+                }
+            }
+        }
+
+        // O quadro é medido depois da espera, só com o trabalho do editor
+        const Profiler::Clock::time_point frameStart = Profiler::Clock::now();
+        {
+            PROFILE_SCOPE("handleEvents");
+            handleEvents();
+        }
+        {
+            PROFILE_SCOPE("update");
+            update();
+        }
+        if (dirtyRegions != DirtyNone) {
+            {
+                PROFILE_SCOPE("render");
+                render();
+            }
+            if (Profiler::instance().isEnabled()) {
+                Profiler::instance().recordFrame(Profiler::Clock::now() - frameStart);
+            }
+        }
     }
+
+    // Saída normal: a gravação automática só serve para recuperar de falhas
+    autosave.discard();
 }
 
 void Editor::handleEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-        } else if (event.type == sf::Event::MouseButtonPressed) {
-            if (event.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2i mousePos(event.mouseButton.x, event.mouseButton.y);
+        handleEvent(event);
+    }
+}
+
+void Editor::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    } else if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+        invalidate(DirtyAll);
+    } else if (event.type == sf::Event::MouseButtonPressed) {
+        if (event.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2i mousePos(event.mouseButton.x, event.mouseButton.y);
+            if (!handleMenuClick(mousePos)) {
                 handleMouseClick(mousePos);
             }
-        } else if (event.type == sf::Event::KeyPressed) {
-            std::cout << "Tecla pressionada: " << event.key.code << std::endl;
-            handleKeyPress(event.key.code);
-        }
-        if (event.type == sf::Event::KeyPressed) {
-            if (event.key.code == sf::Keyboard::LShift || event.key.code == sf::Keyboard::RShift) {
-                toggleGrid();
+        } else if (event.mouseButton.button == sf::Mouse::Right) {
+            eraseEntityAt(sf::Vector2i(event.mouseButton.x, event.mouseButton.y));
+        } else if (event.mouseButton.button == sf::Mouse::Middle) {
+            // Botão do meio arrasta a câmera
+            if (camera.containsScreenPoint(sf::Vector2i(event.mouseButton.x, event.mouseButton.y))) {
+                isPanning = true;
+                lastPanPosition = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
             }
         }
-        if (event.type == sf::Event::KeyReleased) {
-            if (event.key.code == sf::Keyboard::LShift || event.key.code == sf::Keyboard::RShift) {
-                toggleGrid();
-            }
+    } else if (event.type == sf::Event::MouseButtonReleased) {
+        if (event.mouseButton.button == sf::Mouse::Middle) {
+            isPanning = false;
+        }
+    } else if (event.type == sf::Event::MouseMoved) {
+        mousePosition = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+        if (isPanning) {
+            camera.pan(sf::Vector2f(mousePosition - lastPanPosition));
+            lastPanPosition = mousePosition;
+            invalidate(DirtyCanvas);
+        } else if (selectedEntity && editArea.getGlobalBounds().contains(mousePosition.x, mousePosition.y) &&
+                   snapToGrid(mousePosition) != entityPreview.getPosition()) {
+            // O preview só muda ao trocar de célula da grade
+            invalidate(DirtyCanvas);
+        }
+    } else if (event.type == sf::Event::MouseWheelScrolled) {
+        sf::Vector2i mousePos(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+        if (sidebarArea.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
+            scrollSidebar(-event.mouseWheelScroll.delta * SidebarScrollLines * SidebarLineHeight);
+        } else if (camera.containsScreenPoint(mousePos)) {
+            camera.zoomAt(mousePos, event.mouseWheelScroll.delta > 0 ? 1.0f / 1.1f : 1.1f);
+            invalidate(DirtyCanvas);
+        }
+    } else if (event.type == sf::Event::KeyPressed) {
+        LOG_DEBUG("Tecla pressionada: " << event.key.code);
+        handleKeyPress(event.key.code);
+    }
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::LShift || event.key.code == sf::Keyboard::RShift) {
+            toggleGrid();
+        }
+    }
+    if (event.type == sf::Event::KeyReleased) {
+        if (event.key.code == sf::Keyboard::LShift || event.key.code == sf::Keyboard::RShift) {
+            toggleGrid();
         }
     }
 }
 
 void Editor::update() {
-    // Atualize a lógica do editor aqui, se necessário
+    // Texturas pedidas a partir daqui contam como usadas neste quadro
+    entityManager.getTextureCache().beginFrame();
+
+    if (entityManager.isLoading()) {
+        // Cria as entidades já interpretadas sem travar o quadro
+        if (entityManager.processPendingLoads(sf::milliseconds(4)) > 0 || !entityManager.isLoading()) {
+            invalidate(DirtySidebar);
+        }
+        if (!entityManager.isLoading() && entityManager.getEntities().empty()) {
+            LOG_WARNING("Nenhuma entidade carregada. Verifique o diretório de entidades.");
+        }
+    }
+
+    if (entityManager.processPrefetchedTextures(sf::milliseconds(2)) > 0) {
+        invalidate(DirtyCanvas);
+    }
+    if (selectedTexturePending && selectedEntity && selectedEntity->hasSprite() &&
+        !entityManager.isTextureInFlight(selectedPrototypeId)) {
+        // Se o prefetch falhou ou o LRU descartou a textura antes de chegar aqui,
+        // carrega direto uma única vez em vez de esperar para sempre
+        selectedTexture = selectedEntity->acquireTexture();
+        selectedTexturePending = false;
+        createTileThumbnails();
+        invalidate(DirtyFloatingWindow | DirtyCanvas);
+    }
+
+    {
+        // Streaming de chunks conforme a câmera se move
+        PROFILE_SCOPE("updateStreaming");
+        if (scene.updateStreaming(camera.getVisibleArea())) {
+            invalidate(DirtyCanvas);
+        }
+    }
+
+    if (!entityManager.isLoading()) {
+        if (!recoveryChecked) {
+            recoveryChecked = true;
+            if (scene.empty() && autosave.hasRecoveryData()) {
+                autosave.restore(scene, entityManager);
+                invalidate(DirtyCanvas);
+            }
+        }
+        autosave.update(scene, entityManager);
+    }
 }
 
 void Editor::render() {
+    // O conteúdo do back buffer não é preservado entre display(); cada quadro
+    // apresentado é composto por inteiro a partir das regiões
+    {
+        PROFILE_SCOPE("updateEntityPreview");
+        updateEntityPreview(mousePosition);
+    }
     window.clear(sf::Color::White);
     
     window.draw(editArea);
-    window.draw(sidebarArea);
-    
-    window.draw(gridLines.data(), gridLines.size(), sf::PrimitiveType::Lines);
 
-    renderSidebar();
+    // Conteúdo da cena, desenhado pela câmera (recortado à área de edição)
+    window.setView(camera.getView());
 
-    if (showGrid) {
-        drawGrid();
+    {
+        PROFILE_SCOPE("drawGrid");
+        gridRenderer.draw(window, camera.getVisibleArea(), sf::Vector2f(gridSize, gridSize), sf::Color::White);
+
+        if (showGrid) {
+            drawGrid();
+        }
     }
 
     // Renderize as entidades colocadas
-    renderPlacedEntities();
+    {
+        PROFILE_SCOPE("renderPlacedEntities");
+        renderPlacedEntities();
+    }
 
 
     // Renderize o preview da entidade
@@ -462,8 +636,24 @@ void Editor::render() {
         window.draw(entityPreview);
     }
 
+    // Interface em coordenadas de tela
+    window.setView(window.getDefaultView());
+
+    // Painéis em cache: só são redesenhados quando mudam
+    if (dirtyRegions & DirtySidebar) {
+        PROFILE_SCOPE("renderSidebar");
+        renderSidebar();
+    }
+    window.draw(sf::Sprite(sidebarCache.getTexture()));
+
     if (isFloatingWindowOpen && selectedEntity) {
-        drawFloatingWindow();
+        if (dirtyRegions & DirtyFloatingWindow) {
+            PROFILE_SCOPE("drawFloatingWindow");
+            drawFloatingWindow();
+        }
+        sf::Sprite floatingWindowSprite(floatingWindowCache.getTexture());
+        floatingWindowSprite.setPosition(floatingWindowPosition);
+        window.draw(floatingWindowSprite);
     }
     
     // Desenhar menu
@@ -479,7 +669,7 @@ void Editor::render() {
         window.draw(menuBackground);
 
         sf::Text saveOption;
-        saveOption.setFont(menuFont);
+        saveOption.setFont(resources.getFont());
         saveOption.setString("Save");
         saveOption.setCharacterSize(18);
         saveOption.setFillColor(sf::Color::Black);
@@ -487,18 +677,70 @@ void Editor::render() {
         window.draw(saveOption);
     }
 
-    window.display();
+    if (showProfilerOverlay) {
+        drawProfilerOverlay();
+    }
+
+    {
+        PROFILE_SCOPE("display");
+        window.display();
+    }
+    dirtyRegions = DirtyNone;
+}
+
+void Editor::toggleProfiler() {
+    showProfilerOverlay = !showProfilerOverlay;
+    Profiler::instance().setEnabled(showProfilerOverlay);
+    invalidate(DirtyAll);
 }
 
-void Editor::createGrid() {
-    for (float x = 0; x <= 700; x += gridSize) {
-        gridLines.emplace_back(sf::Vector2f(x + editArea.getPosition().x, editArea.getPosition().y));
-        gridLines.emplace_back(sf::Vector2f(x + editArea.getPosition().x, editArea.getPosition().y + 768));
+void Editor::dumpProfilerTrace() {
+    if (!Profiler::instance().isEnabled()) {
+        LOG_INFO("Perfilador desligado; pressione F3 para começar a coletar");
+        return;
+    }
+
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string filename = "trace_" + std::to_string(timestamp) + ".json";
+    if (Profiler::instance().writeChromeTrace(filename, TraceDumpSeconds)) {
+        LOG_INFO("Trace dos últimos " << TraceDumpSeconds << " s gravado em " << filename);
+    } else {
+        LOG_ERROR("Falha ao gravar o trace em " << filename);
     }
-    for (float y = 0; y <= 768; y += gridSize) {
-        gridLines.emplace_back(sf::Vector2f(editArea.getPosition().x, y + editArea.getPosition().y));
-        gridLines.emplace_back(sf::Vector2f(editArea.getPosition().x + 700, y + editArea.getPosition().y));
+}
+
+void Editor::drawProfilerOverlay() {
+    std::ostringstream text;
+    text.setf(std::ios::fixed);
+    text.precision(2);
+
+    float p50 = 0, p95 = 0, p99 = 0;
+    if (Profiler::instance().getFrameTimePercentiles(p50, p95, p99)) {
+        text << "Quadro p50 " << p50 << " ms  p95 " << p95 << " ms  p99 " << p99 << " ms\n";
+    } else {
+        text << "Quadro: aguardando amostras\n";
     }
+    text << "Draw calls: " << scene.getDrawCallCount() << "\n";
+    text << "Chunks: " << scene.getResidentChunkCount() << " / " << scene.getChunkCount()
+         << "  Instâncias: " << scene.size() << "\n";
+    text << "Texturas: " << entityManager.getTextureCache().size() << " ("
+         << entityManager.getTextureCache().getResidentBytes() / (1024 * 1024) << " MB)";
+
+    const std::string overlayText = text.str();
+    sf::Text label(sf::String::fromUtf8(overlayText.begin(), overlayText.end()), resources.getFont(), 12);
+    label.setFillColor(sf::Color::White);
+    sf::FloatRect bounds = label.getLocalBounds();
+
+    sf::FloatRect area = editArea.getGlobalBounds();
+    sf::Vector2f position(area.left + area.width - bounds.width - 16, area.top + 8);
+    sf::RectangleShape background(sf::Vector2f(bounds.width + 12, bounds.top + bounds.height + 10));
+    background.setPosition(position - sf::Vector2f(6, 4));
+    background.setFillColor(sf::Color(0, 0, 0, 170));
+
+    label.setPosition(position);
+    window.draw(background);
+    window.draw(label);
 }
 
 void Editor::handleKeyPress(sf::Keyboard::Key key) {
@@ -509,6 +751,16 @@ void Editor::handleKeyPress(sf::Keyboard::Key key) {
         case sf::Keyboard::Down:
             navigateEntities(1);
             break;
+        case sf::Keyboard::F3:
+            toggleProfiler();
+            break;
+        case sf::Keyboard::F4:
+            dumpProfilerTrace();
+            break;
+        case sf::Keyboard::Home:
+            camera.reset();
+            invalidate(DirtyCanvas);
+            break;
         case sf::Keyboard::Enter:
             if (selectedNodeIndex >= 0) {
                 selectEntityAtIndex(selectedNodeIndex);
@@ -519,91 +771,71 @@ void Editor::handleKeyPress(sf::Keyboard::Key key) {
                 showSaveFileDialog();
             }
             break;
+        case sf::Keyboard::O:
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::LSystem) || sf::Keyboard::isKeyPressed(sf::Keyboard::RSystem)) {
+                showOpenFileDialog();
+            }
+            break;
         default:
             break;
     }
 }
 
 void Editor::selectEntityAtIndex(int index) {
-    std::vector<std::string> entityPaths;
-    collectEntityPaths(rootNode, entityPaths);
-
-    if (index >= 0 && index < static_cast<int>(entityPaths.size())) {
-        selectEntity(entityPaths[index]);
+    if (index >= 0 && index < static_cast<int>(entityIndex.size())) {
+        selectEntity(entityIndex[index]);
     }
 }
 
 void Editor::navigateEntities(int direction) {
-    std::vector<std::string> entityPaths;
-    collectEntityPaths(rootNode, entityPaths);
-
-    if (entityPaths.empty()) return;
+    if (entityIndex.empty()) return;
 
+    const int count = static_cast<int>(entityIndex.size());
     selectedNodeIndex += direction;
-    if (selectedNodeIndex < 0) selectedNodeIndex = entityPaths.size() - 1;
-    if (selectedNodeIndex >= static_cast<int>(entityPaths.size())) selectedNodeIndex = 0;
-
-    std::cout << "Navegando para entidade: " << entityPaths[selectedNodeIndex] << std::endl;
-    selectEntity(entityPaths[selectedNodeIndex]);
+    if (selectedNodeIndex < 0) selectedNodeIndex = count - 1;
+    if (selectedNodeIndex >= count) selectedNodeIndex = 0;
+
+    invalidate(DirtySidebar);
+    scrollToEntity(selectedNodeIndex);
+    LOG_DEBUG("Navegando para entidade: " << entityIndex[selectedNodeIndex]);
+    selectEntity(entityIndex[selectedNodeIndex], false);
+
+    // Antecipa as próximas entradas na direção da navegação
+    for (int i = 1; i <= PrefetchDistance && i < count; ++i) {
+        int index = ((selectedNodeIndex + direction * i) % count + count) % count;
+        entityManager.prefetchTexture(entityManager.getEntityIdByPath(entityIndex[index]));
+    }
 }
 
-void Editor::collectEntityPaths(const FileNode& node, std::vector<std::string>& paths) {
+void Editor::collectEntityPaths(FileNode& node, std::vector<std::string>& paths) {
     if (!node.isDirectory) {
-        paths.push_back(getFullPath(node));
+        node.entityIndex = static_cast<int>(paths.size());
+        paths.push_back(node.path);
     }
-    for (const auto& child : node.children) {
+    for (auto& child : node.children) {
         collectEntityPaths(child, paths);
     }
 }
 
-void Editor::toggleSelectedNode() {
-    int currentIndex = 0;
-    toggleSelectedNodeRecursive(rootNode, currentIndex);
-}
-
-void Editor::toggleSelectedNodeRecursive(FileNode& node, int& currentIndex) {
-    if (currentIndex == selectedNodeIndex) {
-        if (node.isDirectory) {
-            node.isOpen = !node.isOpen;
-        } else {
-            selectEntity(node.name);
-        }
-        return;
-    }
-
-    currentIndex++;
-
-    if (node.isDirectory && node.isOpen) {
-        for (auto& child : node.children) {
-            toggleSelectedNodeRecursive(child, currentIndex);
-            if (currentIndex > selectedNodeIndex) {
-                return;
-            }
-        }
-    }
-}
-
 void Editor::drawFloatingWindow() {
     //std::cout << "Desenhando janela flutuante" << std::endl;
     if (!selectedEntity) {
-        std::cout << "Nenhuma entidade selecionada para desenhar janela flutuante" << std::endl;
+        LOG_DEBUG("Nenhuma entidade selecionada para desenhar janela flutuante");
         return;
     }
 
-    const float windowWidth = 400;
-    const float windowHeight = 500;
-    sf::RectangleShape floatingWindow(sf::Vector2f(windowWidth, windowHeight));
-    floatingWindow.setPosition(floatingWindowPosition);
-    floatingWindow.setFillColor(sf::Color(200, 200, 200));
-    window.draw(floatingWindow);
+    // Desenhado em coordenadas locais; render() posiciona o cache em floatingWindowPosition
+    const float windowWidth = FloatingWindowWidth;
+    const float windowHeight = FloatingWindowHeight;
+    floatingWindowCache.clear(sf::Color(200, 200, 200));
 
-    sf::Text nameText(selectedEntity->getName(), font, 20);
-    nameText.setPosition(floatingWindowPosition.x + 10, floatingWindowPosition.y + 10);
+    sf::Text nameText(selectedEntity->getName(), resources.getFont(), 20);
+    nameText.setPosition(10, 10);
     nameText.setFillColor(sf::Color::Black);
-    window.draw(nameText);
+    floatingWindowCache.draw(nameText);
 
     if (selectedEntity->hasSprite()) {
-        const sf::Texture* texture = selectedEntity->getTexture();
+        const sf::Texture* texture = selectedTexture.get();
         if (texture) {
             sf::Sprite fullSprite(*texture);
             
@@ -612,33 +844,33 @@ void Editor::drawFloatingWindow() {
             float scale = std::min(scaleX, scaleY);
             
             fullSprite.setScale(scale, scale);
-            fullSprite.setPosition(
-                floatingWindowPosition.x + 10,
-                floatingWindowPosition.y + 50
-            );
+            fullSprite.setPosition(10, 50);
             
-            window.draw(fullSprite);
+            floatingWindowCache.draw(fullSprite);
 
+            // Contornos de todos os tiles num único VertexArray
             const auto& spriteDefinitions = selectedEntity->getSpriteDefinitions();
+            sf::VertexArray outlines(sf::Lines);
             for (size_t i = 0; i < spriteDefinitions.size(); ++i) {
                 const auto& spriteDef = spriteDefinitions[i];
-                sf::RectangleShape tileOutline(sf::Vector2f(spriteDef.rect.width * scale, spriteDef.rect.height * scale));
-                tileOutline.setPosition(
-                    fullSprite.getPosition().x + spriteDef.rect.left * scale,
-                    fullSprite.getPosition().y + spriteDef.rect.top * scale
-                );
-                tileOutline.setFillColor(sf::Color::Transparent);
-                tileOutline.setOutlineColor(sf::Color::Black);
-                tileOutline.setOutlineThickness(1);
-                window.draw(tileOutline);
+                sf::Vector2f topLeft(fullSprite.getPosition().x + spriteDef.rect.left * scale,
+                                     fullSprite.getPosition().y + spriteDef.rect.top * scale);
+                sf::Vector2f size(spriteDef.rect.width * scale, spriteDef.rect.height * scale);
+                sf::Vector2f corners[4] = {topLeft, topLeft + sf::Vector2f(size.x, 0), topLeft + size,
+                                           topLeft + sf::Vector2f(0, size.y)};
+                for (int corner = 0; corner < 4; ++corner) {
+                    outlines.append(sf::Vertex(corners[corner], sf::Color::Black));
+                    outlines.append(sf::Vertex(corners[(corner + 1) % 4], sf::Color::Black));
+                }
 
                 if (static_cast<int>(i) == selectedTileIndex) {
-                    sf::RectangleShape highlight(sf::Vector2f(spriteDef.rect.width * scale, spriteDef.rect.height * scale));
-                    highlight.setPosition(tileOutline.getPosition());
+                    sf::RectangleShape highlight(size);
+                    highlight.setPosition(topLeft);
                     highlight.setFillColor(sf::Color(255, 255, 0, 100));
-                    window.draw(highlight);
+                    floatingWindowCache.draw(highlight);
                 }
             }
+            floatingWindowCache.draw(outlines);
         }
         } else {
         sf::Vector2f collisionSize = selectedEntity->getCollisionSize();
@@ -651,132 +883,111 @@ void Editor::drawFloatingWindow() {
         collisionShape.setOutlineColor(sf::Color::Red);
         collisionShape.setOutlineThickness(2);
         collisionShape.setPosition(
-            floatingWindowPosition.x + (windowWidth - collisionShape.getSize().x) / 2,
-            floatingWindowPosition.y + 60 + (windowHeight - 80 - collisionShape.getSize().y) / 2
+            (windowWidth - collisionShape.getSize().x) / 2,
+            60 + (windowHeight - 80 - collisionShape.getSize().y) / 2
         );
         
-        window.draw(collisionShape);
+        floatingWindowCache.draw(collisionShape);
 
-        sf::Texture invisibleTexture;
-        if (invisibleTexture.loadFromFile("entities/invisible.png")) {
-            sf::Sprite invisibleSprite(invisibleTexture);
+        if (const sf::Texture* invisibleTexture = resources.getIcon(EditorResources::Icon::Invisible)) {
+            sf::Sprite invisibleSprite(*invisibleTexture);
             invisibleSprite.setPosition(
-                floatingWindowPosition.x + (windowWidth - invisibleTexture.getSize().x) / 2,
-                floatingWindowPosition.y + 60
+                (windowWidth - invisibleTexture->getSize().x) / 2,
+                60
             );
-            window.draw(invisibleSprite);
+            floatingWindowCache.draw(invisibleSprite);
         }
 
-        sf::Text infoText("Entidade invisível", font, 16);
-        infoText.setPosition(floatingWindowPosition.x + 10, floatingWindowPosition.y + 40);
+        sf::Text infoText("Entidade invisível", resources.getFont(), 16);
+        infoText.setPosition(10, 40);
         infoText.setFillColor(sf::Color::Black);
-        window.draw(infoText);
+        floatingWindowCache.draw(infoText);
     }
+
+    floatingWindowCache.display();
 }
 
-void Editor::updatePlacedEntitySpriteFrame(Entity* entity, int tileIndex) {
-    if (entity && tileIndex >= 0) {
-        entity->setSelectedTileIndex(tileIndex);
-        const auto& spriteDefinitions = entity->getSpriteDefinitions();
-        if (tileIndex < spriteDefinitions.size()) {
-            entity->setTextureRect(spriteDefinitions[tileIndex].rect);
+void Editor::updatePlacedEntitySpriteFrame(const InstanceRef& instance, int tileIndex) {
+    const PlacedInstance* placed = scene.get(instance);
+    if (placed && tileIndex >= 0) {
+        const Entity* entity = entityManager.getEntityById(placed->prototypeId);
+        if (entity && tileIndex < static_cast<int>(entity->getSpriteDefinitions().size())) {
+            scene.setSpriteFrame(instance, tileIndex, entity->getFrameSize(tileIndex));
         }
     }
 }
 
 void Editor::placeEntity(sf::Vector2i mousePos) {
     if (!selectedEntity) {
-        std::cout << "Não foi possível colocar a entidade. Nenhuma entidade selecionada." << std::endl;
+        LOG_DEBUG("Não foi possível colocar a entidade. Nenhuma entidade selecionada.");
         return;
     }
 
-    // Calcula a posição relativa à área de edição
-    sf::Vector2f relativePos(mousePos.x - editArea.getPosition().x, mousePos.y - editArea.getPosition().y);
-
-    // Alinha à grade
-    int gridX = static_cast<int>(relativePos.x / gridSize) * gridSize;
-    int gridY = static_cast<int>(relativePos.y / gridSize) * gridSize;
+    // Posição no mundo, alinhada à grade
+    sf::Vector2f gridPos = snapToGrid(mousePos);
+    int gridX = static_cast<int>(gridPos.x);
+    int gridY = static_cast<int>(gridPos.y);
 
-    auto newEntity = std::make_unique<Entity>(*selectedEntity);
-    
-    // Define a posição da entidade em relação à área de edição
-    newEntity->setPosition(gridX, gridY);
-    
+    int spriteFrame = 0;
     if (selectedEntity->hasSprite() && selectedTileIndex >= 0) {
         const auto& spriteDefinitions = selectedEntity->getSpriteDefinitions();
         if (selectedTileIndex < spriteDefinitions.size()) {
-            newEntity->setTextureRect(spriteDefinitions[selectedTileIndex].rect);
-            newEntity->setSelectedTileIndex(selectedTileIndex);
+            spriteFrame = selectedTileIndex;
         }
-    } else {
-        // Para entidades invisíveis, use o tamanho da colisão
-        sf::Vector2f collisionSize = selectedEntity->getCollisionSize();
-        newEntity->setTextureRect(sf::IntRect(0, 0, collisionSize.x, collisionSize.y));
-        newEntity->setSelectedTileIndex(0);
     }
 
-    placedEntities.push_back(std::move(newEntity));
+    // Apenas o registro compacto é armazenado; sprite e dados vêm do protótipo.
+    // Pintar sobre uma célula ocupada troca a instância em vez de empilhar
+    ChunkedScene::PlaceResult result = scene.place(selectedPrototypeId, sf::Vector2f(gridX, gridY),
+                                                   selectedEntity->getFrameSize(spriteFrame), spriteFrame);
+    if (result == ChunkedScene::PlaceResult::Unchanged) {
+        LOG_DEBUG("Célula (" << gridX << ", " << gridY << ") já contém esta entidade");
+        return;
+    }
+    if (result == ChunkedScene::PlaceResult::Failed) {
+        return;
+    }
+    invalidate(DirtyCanvas);
+
+    LOG_DEBUG("Entidade " << (selectedEntity->hasSprite() ? "" : "invisível ")
+              << (result == ChunkedScene::PlaceResult::Replaced ? "substituída" : "colocada")
+              << " na posição: (" << gridX << ", " << gridY << ")");
+    LOG_DEBUG("Total de entidades colocadas: " << scene.size());
+}
 
-    std::cout << "Entidade " << (selectedEntity->hasSprite() ? "" : "invisível ")
-              << "colocada na posição: (" << gridX << ", " << gridY << ")" << std::endl;
-    std::cout << "Total de entidades colocadas: " << placedEntities.size() << std::endl;
+sf::Vector2f Editor::snapToGrid(sf::Vector2i mousePos) const {
+    sf::Vector2f worldPos = camera.screenToWorld(mousePos);
+    return sf::Vector2f(std::floor(worldPos.x / gridSize) * gridSize,
+                        std::floor(worldPos.y / gridSize) * gridSize);
 }
 
 void Editor::updateEntityPreview(sf::Vector2i mousePos) {
     if (selectedEntity && editArea.getGlobalBounds().contains(mousePos.x, mousePos.y)) {
-        sf::Vector2f adjustedPos(mousePos.x - editArea.getPosition().x, mousePos.y - editArea.getPosition().y);
-
-        // Alinha à grade
-        int gridX = static_cast<int>(adjustedPos.x / gridSize) * gridSize;
-        int gridY = static_cast<int>(adjustedPos.y / gridSize) * gridSize;
-
-        // Define a posição do preview
-        entityPreview.setPosition(editArea.getPosition().x + gridX, editArea.getPosition().y + gridY);
+        // Define a posição do preview (em coordenadas de mundo)
+        entityPreview.setPosition(snapToGrid(mousePos));
         
         if (selectedEntity->hasSprite()) {
             const auto& spriteDefinitions = selectedEntity->getSpriteDefinitions();
             if (selectedTileIndex >= 0 && selectedTileIndex < spriteDefinitions.size()) {
                 entityPreview.setTextureRect(spriteDefinitions[selectedTileIndex].rect);
             }
-            entityPreview.setTexture(*selectedEntity->getTexture());
+            if (selectedTexture) {
+                entityPreview.setTexture(*selectedTexture);
+            }
             entityPreview.setColor(sf::Color(255, 255, 255, 128)); // Semi-transparente
         } else {
             // Para entidades invisíveis, use o tamanho da colisão
             sf::Vector2f collisionSize = selectedEntity->getCollisionSize();
-            entityPreview.setTexture(sf::Texture());  // Remove a textura
+            // Textura branca repetida, tingida por setColor
+            if (const sf::Texture* solid = resources.getIcon(EditorResources::Icon::Solid)) {
+                entityPreview.setTexture(*solid);
+            }
             entityPreview.setTextureRect(sf::IntRect(0, 0, collisionSize.x, collisionSize.y));
             entityPreview.setColor(sf::Color(200, 0, 0, 128));  // Vermelho semi-transparente
         }
     }
 }
 
-void Editor::renderInvisibleEntity(sf::RenderWindow& window, const Entity* entity) {
-    sf::Vector2f entityPos = entity->getPosition();
-    entityPos.x += editArea.getPosition().x;
-    entityPos.y += editArea.getPosition().y;
-    sf::Vector2f entitySize = entity->getCollisionSize();
-
-    sf::RectangleShape shape(entitySize);
-    shape.setPosition(entityPos);
-    shape.setFillColor(sf::Color(200, 0, 0, 128));  // Vermelho semi-transparente
-    shape.setOutlineColor(sf::Color::Red);
-    shape.setOutlineThickness(1);
-    window.draw(shape);
-
-    static sf::Texture invisibleTexture;
-    static bool textureLoaded = false;
-    if (!textureLoaded) {
-        textureLoaded = invisibleTexture.loadFromFile("entities/invisible.png");
-    }
-    
-    if (textureLoaded) {
-        sf::Sprite invisibleSprite(invisibleTexture);
-        invisibleSprite.setPosition(entityPos);
-        invisibleSprite.setScale(entitySize.x / invisibleTexture.getSize().x, entitySize.y / invisibleTexture.getSize().y);
-        window.draw(invisibleSprite);
-    }
-}
-
 void Editor::createTileThumbnails() {
     tileThumbnails.clear();
     if (selectedEntity) {
@@ -790,7 +1001,7 @@ void Editor::createTileThumbnails() {
         const auto& spriteDefinitions = selectedEntity->getSpriteDefinitions();
         for (const auto& spriteDef : spriteDefinitions) {
             sf::RectangleShape thumbnail(sf::Vector2f(thumbnailSize, thumbnailSize));
-            thumbnail.setTexture(selectedEntity->getTexture());
+            thumbnail.setTexture(selectedTexture.get());
             thumbnail.setTextureRect(spriteDef.rect);
             thumbnail.setPosition(xPos, yPos);
 
@@ -810,11 +1021,11 @@ void Editor::createTileThumbnails() {
 
 void Editor::handleFloatingWindowClick(sf::Vector2f localPosition) {
     if (selectedEntity && selectedEntity->hasSprite()) {
-        const sf::Texture* texture = selectedEntity->getTexture();
+        const sf::Texture* texture = selectedTexture.get();
         if (!texture) return;
 
-        const float windowWidth = 400;
-        const float windowHeight = 500;
+        const float windowWidth = FloatingWindowWidth;
+        const float windowHeight = FloatingWindowHeight;
         
         sf::Vector2f spritePosition(10, 50);
         sf::Vector2f spriteSize(texture->getSize());
@@ -838,44 +1049,48 @@ void Editor::handleFloatingWindowClick(sf::Vector2f localPosition) {
                     relativePos.y >= spriteDef.rect.top - 2.0f && 
                     relativePos.y < spriteDef.rect.top + spriteDef.rect.height + 2.0f) {
                     selectedTileIndex = i;
-                    std::cout << "Tile selecionado: " << i << std::endl;
+                    invalidate(DirtyFloatingWindow | DirtyCanvas);
+                    LOG_DEBUG("Tile selecionado: " << i);
                     return;
                 }
             }
-            std::cout << "Nenhum tile selecionado." << std::endl;
+            LOG_DEBUG("Nenhum tile selecionado.");
         } else {
-            std::cout << "Clique fora da área do sprite." << std::endl;
+            LOG_DEBUG("Clique fora da área do sprite.");
         }
     }
 }
 
 void Editor::saveScene(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Não foi possível abrir o arquivo para salvar a cena." << std::endl;
-        return;
+    // Arquivo de trabalho binário (.escb); o .esc fica para exportação
+    if (BinaryScene::save(filename, scene, entityManager)) {
+        LOG_INFO("Cena salva em " << filename);
+    } else {
+        LOG_ERROR("Não foi possível salvar a cena em " << filename);
     }
+}
 
-    for (const auto& entity : placedEntities) {
-        file << entity->getName() << " " 
-             << entity->getPosition().x << " " 
-             << entity->getPosition().y << " ";
-        
-        if (entity->hasSprite()) {
-            const sf::IntRect& textureRect = entity->getSprite().getTextureRect();
-            file << textureRect.left << " " 
-                 << textureRect.top << " " 
-                 << textureRect.width << " " 
-                 << textureRect.height;
-        } else {
-            file << "0 0 0 0";  // Placeholder para entidades sem sprite
+void Editor::loadScene(const std::string& filename) {
+    sf::Clock clock;
+    bool loaded = false;
+    if (fs::path(filename).extension() == ".esc") {
+        SceneImporter importer;
+        loaded = importer.importEsc(filename, scene, entityManager);
+        if (loaded && importer.getSkippedCount() > 0) {
+            LOG_WARNING(importer.getSkippedCount() << " instâncias ignoradas (entidade não encontrada)");
         }
-        
-        file << std::endl;
+    } else {
+        loaded = BinaryScene::load(filename, scene, entityManager);
     }
 
-    file.close();
-    std::cout << "Cena salva em " << filename << std::endl;
+    if (loaded) {
+        saveFilePath = filename;
+        invalidate(DirtyCanvas);
+        LOG_INFO("Cena carregada de " << filename << " (" << scene.size() << " instâncias, "
+                 << clock.getElapsedTime().asMilliseconds() << " ms)");
+    } else {
+        LOG_ERROR("Não foi possível carregar a cena de " << filename);
+    }
 }
 
 void Editor::updateGridSize() {
@@ -884,19 +1099,11 @@ void Editor::updateGridSize() {
 
 void Editor::toggleGrid() {
     showGrid = !showGrid;
+    invalidate(DirtyCanvas);
 }
 
 void Editor::drawGrid() {
     if (!showGrid) return;
 
-    sf::VertexArray lines(sf::Lines);
-    for (float x = editArea.getPosition().x; x <= editArea.getPosition().x + editArea.getSize().x; x += currentGridSize.x) {
-        lines.append(sf::Vertex(sf::Vector2f(x, editArea.getPosition().y), sf::Color(200, 200, 200, 100)));
-        lines.append(sf::Vertex(sf::Vector2f(x, editArea.getPosition().y + editArea.getSize().y), sf::Color(200, 200, 200, 100)));
-    }
-    for (float y = editArea.getPosition().y; y <= editArea.getPosition().y + editArea.getSize().y; y += currentGridSize.y) {
-        lines.append(sf::Vertex(sf::Vector2f(editArea.getPosition().x, y), sf::Color(200, 200, 200, 100)));
-        lines.append(sf::Vertex(sf::Vector2f(editArea.getPosition().x + editArea.getSize().x, y), sf::Color(200, 200, 200, 100)));
-    }
-    window.draw(lines);
+    overlayGridRenderer.draw(window, camera.getVisibleArea(), currentGridSize, sf::Color(200, 200, 200, 100));
 }
\ No newline at end of file
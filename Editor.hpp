@@ -1,6 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "EntityManager.hpp"
+#include "ChunkedScene.hpp"
+#include "Autosave.hpp"
+#include "Camera.hpp"
+#include "GridRenderer.hpp"
+#include "EditorResources.hpp"
+#include "Profiler.hpp"
 #include <tinyxml2.h>
 #include <vector>
 #include <string>
@@ -8,11 +14,19 @@
 
 struct FileNode {
     std::string name;
+    std::string path;      // Caminho completo, a partir de "entities"
     bool isDirectory;
     bool isOpen;
+    int entityIndex = -1;  // Posição em Editor::entityIndex (só arquivos)
     std::vector<FileNode> children;
 };
 
+// Linha visível da barra lateral
+struct SidebarRow {
+    FileNode* node;
+    int depth;
+};
+
 class Editor {
     sf::Vector2f currentGridSize;
     bool showGrid;
@@ -21,84 +35,140 @@ public:
     Editor();
     void run();
     void exportScene(const std::string& filename);
+    // Limite de quadros por segundo durante a interação; 0 = sem limite
+    void setFrameRateLimit(unsigned limit);
 
 private:
+    // Regiões da janela que mudaram desde o último quadro (ver invalidate)
+    enum DirtyRegion : unsigned {
+        DirtyNone = 0,
+        DirtySidebar = 1 << 0,
+        DirtyCanvas = 1 << 1,
+        DirtyFloatingWindow = 1 << 2,
+        DirtyMenu = 1 << 3,
+        DirtyAll = DirtySidebar | DirtyCanvas | DirtyFloatingWindow | DirtyMenu
+    };
+
+    static constexpr unsigned DefaultFrameRateLimit = 60;
+    static const sf::Time BackgroundPollInterval;  // Espera entre verificações enquanto há trabalho em segundo plano
+    static const sf::Time EventPumpInterval;       // Passo de waitEventFor (o mesmo do waitEvent do SFML 2)
+
     sf::RenderWindow window;
+    unsigned dirtyRegions = DirtyAll;
+    sf::Vector2i mousePosition;  // Última posição recebida em MouseMoved
     EntityManager entityManager;
     
     sf::RectangleShape projectArea;
     sf::RectangleShape editArea;
     sf::RectangleShape sidebarArea;
+    // Painéis desenhados uma vez e reaproveitados até DirtySidebar/DirtyFloatingWindow
+    sf::RenderTexture sidebarCache;
+    sf::RenderTexture floatingWindowCache;
+    Camera camera;
+    bool isPanning = false;
+    sf::Vector2i lastPanPosition;
     sf::Sprite entityPreview;
 
     std::vector<sf::RectangleShape> tileThumbnails;
     std::vector<sf::RectangleShape> placedTiles;
-    std::vector<std::unique_ptr<Entity>> placedEntities;
+    ChunkedScene scene;
+    Autosave autosave{"autosave", sf::seconds(120)};
+    bool recoveryChecked = false;  // A gravação automática só é restaurada depois que as entidades carregam
+    EditorResources resources;
+
+    // Perfilador: F3 liga a coleta e o painel, F4 grava os últimos segundos como trace
+    bool showProfilerOverlay = false;
+    static constexpr float TraceDumpSeconds = 10.0f;
+    void toggleProfiler();
+    void dumpProfilerTrace();
+    void drawProfilerOverlay();
 
-    sf::Font menuFont;
     std::vector<sf::Text> menuItems;
     bool isMenuOpen;
     std::string saveFilePath;
     
     Entity* selectedEntity;
+    std::shared_ptr<const sf::Texture> selectedTexture;  // Fixa a textura da seleção no TextureCache
+    PrototypeId selectedPrototypeId = InvalidPrototypeId;
+    bool selectedTexturePending = false;  // Esperando o prefetch da textura da seleção
     int selectedTileIndex = -1;
     
     bool isFloatingWindowOpen;
+    static constexpr float FloatingWindowWidth = 400;
+    static constexpr float FloatingWindowHeight = 500;
     sf::Vector2f floatingWindowPosition;
-    sf::Font font;
 
     int selectedEntityIndex = -1;
 
     // Grade
     int gridSize;
-    std::vector<sf::Vertex> gridLines;
+    GridRenderer gridRenderer;         // Grade de gridSize, sempre visível
+    GridRenderer overlayGridRenderer;  // Grade de currentGridSize, com Shift pressionado
     
     // Estrutura de arquivos
     FileNode rootNode;
+    std::vector<std::string> entityIndex;  // Todos os .ent em ordem da árvore (ver collectEntityPaths)
+    // Linhas dos diretórios abertos, achatadas; atualizadas só ao abrir ou fechar um diretório
+    std::vector<SidebarRow> sidebarRows;
+    float sidebarScroll = 0;
+    static constexpr float SidebarPadding = 10.0f;
+    static constexpr float SidebarLineHeight = 20.0f;
+    static constexpr float SidebarIndent = 20.0f;
+    static constexpr float SidebarScrollLines = 3.0f;  // Linhas por passo da roda do mouse
+    static constexpr int PrefetchDistance = 4;  // Entradas pré-carregadas à frente na navegação
     int selectedNodeIndex;
     int currentNodeIndex = 0;
 
-    void updatePlacedEntitySpriteFrame(Entity* entity, int tileIndex);
+    void updatePlacedEntitySpriteFrame(const InstanceRef& instance, int tileIndex);
     void placeEntity(sf::Vector2i mousePos);
+    sf::Vector2f snapToGrid(sf::Vector2i mousePos) const;
     void handleEvents();
+    void handleEvent(const sf::Event& event);
+    void invalidate(unsigned regions) { dirtyRegions |= regions; }
+    // Carregamentos ou gravações em andamento que ainda podem mudar a tela
+    bool hasBackgroundWork() const;
+    // waitEvent com prazo; false se o prazo passou sem eventos
+    bool waitEventFor(sf::Event& event, sf::Time timeout);
     void update();
     void render();
     void loadEntities();
     void createTileThumbnails();
     void handleMouseClick(sf::Vector2i mousePos);
+    void handleEditAreaClick(sf::Vector2i mousePos);
+    bool findInstanceAt(sf::Vector2i mousePos, InstanceRef& out);
+    void eraseEntityAt(sf::Vector2i mousePos);
+    void pickEntityAt(sf::Vector2i mousePos);
     void placeTile(sf::Vector2i mousePos);
     void handleFloatingWindowClick(sf::Vector2f relativePos);
     void drawFloatingWindow();
     void saveScene(const std::string& filename);
+    void loadScene(const std::string& filename);
     void updateGridSize();
     void toggleGrid();
     void drawGrid();
-    void createGrid();
 
     // Funções modificadas ou novas
     void renderSidebar();
     void handleKeyPress(sf::Keyboard::Key key);
-    void selectEntity(const std::string& path);
+    // waitForTexture = false: não bloqueia em I/O; a textura é pré-carregada em segundo plano
+    void selectEntity(const std::string& path, bool waitForTexture = true);
     void showEntityDetails();
     void loadFileStructure(const std::string& path, FileNode& node);
-    std::string getClickedEntityPath(float x, float y, float& yOffset, int& outIndex);
-    std::string getClickedEntityPathRecursive(const FileNode& node, int depth, float x, float y, float& yOffset, int& currentIndex);
-    std::string getFullPath(const FileNode& node);
-    void toggleNodeOpen(FileNode& node);
-    void toggleSelectedNode();
-    void toggleSelectedNodeRecursive(FileNode& node, int& currentIndex);
-    void renderFileNode(const FileNode& node, int depth, float& yOffset, int& currentIndex);
+    void renderSidebarRow(const SidebarRow& row, float y);
+    void appendVisibleRows(FileNode& node, int depth, std::vector<SidebarRow>& rows);
+    void toggleDirectoryRow(std::size_t row);
+    int sidebarRowAt(float y) const;  // -1 fora das linhas
+    void scrollSidebar(float delta);
+    void scrollToEntity(int index);
     void navigateEntities(int direction);
     void selectEntityAtIndex(int index);
-    void collectEntityPaths(const FileNode& node, std::vector<std::string>& paths);
+    void collectEntityPaths(FileNode& node, std::vector<std::string>& paths);
     std::string selectedEntityPath;
     void updateEntityPreview(sf::Vector2i mousePos);
-    void renderInvisibleEntity(sf::RenderWindow &window, const Entity *entity);
-    void addCustomDataVariable(tinyxml2::XMLDocument &doc, tinyxml2::XMLElement *customData,
-                               const std::string &type, const std::string &name, const std::string &value);
     void createMenu();
-    void handleMenu();
+    bool handleMenuClick(sf::Vector2i mousePos);
     void showSaveFileDialog();
+    void showOpenFileDialog();
     
     // Nova função adicionada
     void renderPlacedEntities();
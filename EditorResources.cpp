@@ -0,0 +1,37 @@
+#include "EditorResources.hpp"
+#include "Log.hpp"
+
+namespace {
+
+const char* const InvisibleIconPath = "entities/invisible.png";
+const char* const FontPath = "/System/Library/Fonts/Helvetica.ttc";
+
+}
+
+bool EditorResources::load() {
+    bool loaded = true;
+
+    auto invisible = std::make_unique<sf::Texture>();
+    if (invisible->loadFromFile(InvisibleIconPath)) {
+        icons[static_cast<std::size_t>(Icon::Invisible)] = std::move(invisible);
+    } else {
+        LOG_ERROR("Falha ao carregar o ícone " << InvisibleIconPath);
+        loaded = false;
+    }
+
+    sf::Image white;
+    white.create(1, 1, sf::Color::White);
+    auto solid = std::make_unique<sf::Texture>();
+    if (solid->loadFromImage(white)) {
+        solid->setRepeated(true);
+        icons[static_cast<std::size_t>(Icon::Solid)] = std::move(solid);
+    } else {
+        loaded = false;
+    }
+
+    if (!font.loadFromFile(FontPath)) {
+        LOG_ERROR("Falha ao carregar a fonte");
+        loaded = false;
+    }
+    return loaded;
+}
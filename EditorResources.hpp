@@ -0,0 +1,27 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+
+// Recursos fixos da interface do editor (ícones e fonte), carregados uma única
+// vez em load(). Depois disso nenhum acesso vai ao disco: o desenho de cada
+// quadro só consulta ponteiros já residentes.
+class EditorResources {
+public:
+    enum class Icon {
+        Invisible,  // entities/invisible.png, sobreposto às entidades sem sprite
+        Solid,      // 1x1 branco, gerado em memória, para retângulos coloridos em sprites
+        Count
+    };
+
+    bool load();
+
+    // nullptr se o ícone não pôde ser carregado
+    const sf::Texture* getIcon(Icon icon) const { return icons[static_cast<std::size_t>(icon)].get(); }
+    const sf::Font& getFont() const { return font; }
+
+private:
+    std::array<std::unique_ptr<sf::Texture>, static_cast<std::size_t>(Icon::Count)> icons;
+    sf::Font font;
+};
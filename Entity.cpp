@@ -1,60 +1,104 @@
 #include "Entity.hpp"
+#include "Log.hpp"
 #include <tinyxml2.h>
-#include <iostream>
 #include <filesystem>
+#include <algorithm>
 
 namespace fs = std::filesystem;
 
-Entity::Entity(const std::string& filename) {
+Entity::Entity(const std::string& filename, TextureCache& textureCache) {
+    EntityDefinition definition;
+    if (!parseDefinition(filename, definition)) {
+        return;
+    }
+
+    if (!definition.texturePath.empty()) {
+        TextureCache::readImageSize(definition.texturePath, definition.textureSize);
+    }
+    initialize(definition, textureCache);
+}
+
+Entity::Entity(const EntityDefinition& definition, TextureCache& textureCache) {
+    initialize(definition, textureCache);
+}
+
+bool Entity::parseDefinition(const std::string& filename, EntityDefinition& definition) {
     tinyxml2::XMLDocument doc;
     if (doc.LoadFile(filename.c_str()) != tinyxml2::XML_SUCCESS) {
-        std::cerr << "Failed to load " << filename << std::endl;
-        return;
+        LOG_ERROR("Failed to load " << filename);
+        return false;
     }
 
     auto root = doc.FirstChildElement("Ethanon");
     if (!root) {
-        std::cerr << "Missing Ethanon root element in " << filename << std::endl;
-        return;
+        LOG_ERROR("Missing Ethanon root element in " << filename);
+        return false;
     }
 
     auto entityElement = root->FirstChildElement("Entity");
     if (!entityElement) {
-        std::cerr << "Missing Entity element in " << filename << std::endl;
-        return;
+        LOG_ERROR("Missing Entity element in " << filename);
+        return false;
     }
 
-    name = filename;
+    definition.name = filename;
 
     auto spriteElement = entityElement->FirstChildElement("Sprite");
     if (spriteElement && spriteElement->GetText()) {
-        spritePath = spriteElement->GetText();
+        definition.spritePath = spriteElement->GetText();
         fs::path entityPath(filename);
-        fs::path texturePath = entityPath.parent_path() / spritePath;
-        
-        if (!texture.loadFromFile(texturePath.string())) {
-            std::cerr << "Failed to load texture: " << texturePath << std::endl;
-        } else {
-            std::cout << "Successfully loaded texture: " << texturePath << std::endl;
-            sprite.setTexture(texture);
-            
-            auto spriteCutElement = entityElement->FirstChildElement("SpriteCut");
-            if (spriteCutElement) {
-                int cutX = spriteCutElement->IntAttribute("x", 1);
-                int cutY = spriteCutElement->IntAttribute("y", 1);
-                loadTextureAtlas(texturePath.string(), cutX, cutY);
-            } else {
-                loadTextureAtlas(texturePath.string(), 1, 1);
-            }
+        definition.texturePath = (entityPath.parent_path() / definition.spritePath).string();
+
+        auto spriteCutElement = entityElement->FirstChildElement("SpriteCut");
+        if (spriteCutElement) {
+            definition.cutX = std::max(1, spriteCutElement->IntAttribute("x", 1));
+            definition.cutY = std::max(1, spriteCutElement->IntAttribute("y", 1));
         }
+
+        definition.hasAtlas = loadTextureAtlas(definition.texturePath, definition.spriteDefinitions);
     }
 
     auto collisionElement = entityElement->FirstChildElement("Collision");
     if (collisionElement) {
         auto sizeElement = collisionElement->FirstChildElement("Size");
         if (sizeElement) {
-            collisionSize.x = sizeElement->FloatAttribute("x");
-            collisionSize.y = sizeElement->FloatAttribute("y");
+            definition.collisionSize.x = sizeElement->FloatAttribute("x");
+            definition.collisionSize.y = sizeElement->FloatAttribute("y");
+        }
+    }
+
+    auto customDataElement = entityElement->FirstChildElement("CustomData");
+    if (customDataElement) {
+        loadCustomData(customDataElement, definition.customData);
+    }
+
+    return true;
+}
+
+void Entity::initialize(const EntityDefinition& definition, TextureCache& cache) {
+    name = definition.name;
+    spritePath = definition.spritePath;
+    collisionSize = definition.collisionSize;
+    customData = definition.customData;
+    textureCache = &cache;
+
+    if (!spritePath.empty()) {
+        if (definition.textureSize.x == 0 || definition.textureSize.y == 0) {
+            LOG_ERROR("Failed to load texture: " << definition.texturePath);
+        } else {
+            // A textura em si só é carregada no primeiro getTexture(); o caminho já
+            // fica na forma de chave do cache para o desenho não normalizar por instância
+            texturePath = TextureCache::normalizePath(definition.texturePath);
+            textureSize = definition.textureSize;
+            sprite.setTextureRect(sf::IntRect(0, 0, textureSize.x, textureSize.y));
+
+            // Sem atlas XML, usar SpriteCut ou dividir a textura em tiles
+            if (definition.hasAtlas) {
+                spriteDefinitions = definition.spriteDefinitions;
+            } else {
+                buildSpriteCut(definition.cutX, definition.cutY);
+            }
+            LOG_DEBUG("Loaded " << spriteDefinitions.size() << " sprite definitions.");
         }
     }
 
@@ -65,23 +109,43 @@ Entity::Entity(const std::string& filename) {
         collisionDef.rect = sf::IntRect(0, 0, collisionSize.x, collisionSize.y);
         spriteDefinitions.push_back(collisionDef);
     }
-
-    auto customDataElement = entityElement->FirstChildElement("CustomData");
-    if (customDataElement) {
-        loadCustomData(customDataElement);
-    }
 }
 
 Entity::Entity(const Entity& other)
-    : sprite(other.sprite), texture(other.texture), name(other.name),
+    : sprite(other.sprite), textureCache(other.textureCache), texturePath(other.texturePath),
+      textureSize(other.textureSize), name(other.name),
       spriteDefinitions(other.spriteDefinitions), customData(other.customData),
       spritePath(other.spritePath), collisionSize(other.collisionSize),
       selectedTileIndex(other.selectedTileIndex) 
 {
-    sprite.setTexture(texture);
+    // A textura é compartilhada via TextureCache; getTexture() revincula o sprite se preciso
+}
+
+const sf::Texture* Entity::getTexture() const {
+    if (texturePath.empty() || !textureCache) {
+        return nullptr;
+    }
+
+    const sf::Texture* texture = textureCache->requestNormalized(texturePath);
+    if (texture && sprite.getTexture() != texture) {
+        sprite.setTexture(*texture);
+    }
+    return texture;
+}
+
+std::shared_ptr<const sf::Texture> Entity::acquireTexture() const {
+    if (texturePath.empty() || !textureCache) {
+        return nullptr;
+    }
+
+    auto texture = textureCache->acquire(texturePath);
+    if (texture && sprite.getTexture() != texture.get()) {
+        sprite.setTexture(*texture);
+    }
+    return texture;
 }
 
-void Entity::loadCustomData(const tinyxml2::XMLElement* customDataElement) {
+void Entity::loadCustomData(const tinyxml2::XMLElement* customDataElement, std::map<std::string, std::string>& values) {
     for (auto variableElement = customDataElement->FirstChildElement("Variable");
          variableElement;
          variableElement = variableElement->NextSiblingElement("Variable")) {
@@ -89,10 +153,10 @@ void Entity::loadCustomData(const tinyxml2::XMLElement* customDataElement) {
         auto nameElement = variableElement->FirstChildElement("Name");
         auto valueElement = variableElement->FirstChildElement("Value");
         
-        if (nameElement && valueElement) {
+        if (nameElement && valueElement && nameElement->GetText() && valueElement->GetText()) {
             std::string key = nameElement->GetText();
             std::string value = valueElement->GetText();
-            customData[key] = value;
+            values[key] = value;
         }
     }
 }
@@ -109,48 +173,50 @@ std::string Entity::getCustomData(const std::string& key) const {
     return "";
 }
 
-void Entity::loadTextureAtlas(const std::string& atlasPath, int cutX, int cutY) {
+bool Entity::loadTextureAtlas(const std::string& atlasPath, std::vector<SpriteDefinition>& definitions) {
     tinyxml2::XMLDocument atlasDoc;
     std::string xmlPath = atlasPath.substr(0, atlasPath.find_last_of('.')) + ".xml";
     
-    if (atlasDoc.LoadFile(xmlPath.c_str()) == tinyxml2::XML_SUCCESS) {
-        auto atlas = atlasDoc.FirstChildElement("TextureAtlas");
-        if (atlas) {
-            for (auto spriteElement = atlas->FirstChildElement("sprite"); spriteElement; spriteElement = spriteElement->NextSiblingElement("sprite")) {
-                const char* name = spriteElement->Attribute("n");
-                if (!name) continue;
-
-                SpriteDefinition spriteDef;
-                spriteDef.name = name;
-                spriteDef.rect = sf::IntRect(
-                    spriteElement->IntAttribute("x"),
-                    spriteElement->IntAttribute("y"),
-                    spriteElement->IntAttribute("w"),
-                    spriteElement->IntAttribute("h")
-                );
-                spriteDefinitions.push_back(spriteDef);
-            }
-        }
-    } else {
-        // Se não houver arquivo XML, usar SpriteCut ou dividir a textura em tiles
-        sf::Vector2u textureSize = texture.getSize();
-        int tileWidth = textureSize.x / cutX;
-        int tileHeight = textureSize.y / cutY;
-
-        for (int y = 0; y < cutY; ++y) {
-            for (int x = 0; x < cutX; ++x) {
-                SpriteDefinition spriteDef;
-                spriteDef.name = "tile_" + std::to_string(y * cutX + x);
-                spriteDef.rect = sf::IntRect(x * tileWidth, y * tileHeight, tileWidth, tileHeight);
-                spriteDefinitions.push_back(spriteDef);
-            }
+    if (atlasDoc.LoadFile(xmlPath.c_str()) != tinyxml2::XML_SUCCESS) {
+        return false;
+    }
+
+    auto atlas = atlasDoc.FirstChildElement("TextureAtlas");
+    if (atlas) {
+        for (auto spriteElement = atlas->FirstChildElement("sprite"); spriteElement; spriteElement = spriteElement->NextSiblingElement("sprite")) {
+            const char* name = spriteElement->Attribute("n");
+            if (!name) continue;
+
+            SpriteDefinition spriteDef;
+            spriteDef.name = name;
+            spriteDef.rect = sf::IntRect(
+                spriteElement->IntAttribute("x"),
+                spriteElement->IntAttribute("y"),
+                spriteElement->IntAttribute("w"),
+                spriteElement->IntAttribute("h")
+            );
+            definitions.push_back(spriteDef);
         }
     }
+    return true;
+}
 
-    std::cout << "Loaded " << spriteDefinitions.size() << " sprite definitions." << std::endl;
+void Entity::buildSpriteCut(int cutX, int cutY) {
+    int tileWidth = textureSize.x / cutX;
+    int tileHeight = textureSize.y / cutY;
+
+    for (int y = 0; y < cutY; ++y) {
+        for (int x = 0; x < cutX; ++x) {
+            SpriteDefinition spriteDef;
+            spriteDef.name = "tile_" + std::to_string(y * cutX + x);
+            spriteDef.rect = sf::IntRect(x * tileWidth, y * tileHeight, tileWidth, tileHeight);
+            spriteDefinitions.push_back(spriteDef);
+        }
+    }
 }
 
 void Entity::draw(sf::RenderWindow& window) const {
+    if (!getTexture()) return;
     window.draw(sprite);
 }
 
@@ -174,6 +240,14 @@ sf::Vector2f Entity::getCollisionSize() const {
     }
 }
 
+sf::Vector2f Entity::getFrameSize(int frame) const {
+    if (hasSprite() && frame >= 0 && frame < static_cast<int>(spriteDefinitions.size())) {
+        const sf::IntRect& rect = spriteDefinitions[frame].rect;
+        return sf::Vector2f(rect.width, rect.height);
+    }
+    return getCollisionSize();
+}
+
 sf::Vector2f Entity::getPosition() const {
     return sprite.getPosition();
 }
@@ -185,19 +259,19 @@ void Entity::setPosition(float x, float y) {
 bool Entity::loadFromFile(const std::string& filename) {
     tinyxml2::XMLDocument doc;
     if (doc.LoadFile(filename.c_str()) != tinyxml2::XML_SUCCESS) {
-        std::cerr << "Falha ao carregar o arquivo: " << filename << std::endl;
+        LOG_ERROR("Falha ao carregar o arquivo: " << filename);
         return false;
     }
 
     tinyxml2::XMLElement* root = doc.FirstChildElement("Ethanon");
     if (!root) {
-        std::cerr << "Arquivo XML inválido: " << filename << std::endl;
+        LOG_ERROR("Arquivo XML inválido: " << filename);
         return false;
     }
 
     tinyxml2::XMLElement* entityElement = root->FirstChildElement("Entity");
     if (!entityElement) {
-        std::cerr << "Elemento 'Entity' não encontrado: " << filename << std::endl;
+        LOG_ERROR("Elemento 'Entity' não encontrado: " << filename);
         return false;
     }
 
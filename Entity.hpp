@@ -3,17 +3,35 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <tinyxml2.h>
+#include "TextureCache.hpp"
 
 struct SpriteDefinition {
     std::string name;
     sf::IntRect rect;
 };
 
+// Conteúdo de um .ent (e do atlas XML) já interpretado, sem recursos de GPU.
+// Pode ser produzido fora da thread principal.
+struct EntityDefinition {
+    std::string name;          // Caminho do .ent
+    std::string spritePath;    // Como escrito em <Sprite>
+    std::string texturePath;   // Resolvido relativo ao .ent
+    sf::Vector2u textureSize;  // Preenchido pelo carregador; zero se a imagem não pôde ser lida
+    int cutX = 1;
+    int cutY = 1;
+    bool hasAtlas = false;     // spriteDefinitions veio de um atlas XML
+    std::vector<SpriteDefinition> spriteDefinitions;
+    sf::Vector2f collisionSize;
+    std::map<std::string, std::string> customData;
+};
+
 class Entity {
 public:
-    Entity(const std::string& filename);
-    Entity(const Entity& other);  // Copy constructor
+    Entity(const std::string& filename, TextureCache& textureCache);
+    Entity(const EntityDefinition& definition, TextureCache& textureCache);
+    Entity(const Entity& other);  // Copy constructor (compartilha o cache de texturas)
 
     void draw(sf::RenderWindow& window) const;
     sf::Vector2f getSize() const;
@@ -22,7 +40,12 @@ public:
     bool loadFromFile(const std::string &filename);
     const sf::Sprite &getSprite() const { return sprite; }
     const std::vector<SpriteDefinition>& getSpriteDefinitions() const { return spriteDefinitions; }
-    const sf::Texture* getTexture() const { return sprite.getTexture(); }
+    // A textura só é carregada no primeiro uso e pode ser descartada pelo TextureCache
+    // em quadros seguintes; o ponteiro vale até o fim do quadro atual
+    const sf::Texture* getTexture() const;
+    // Mantém a textura residente enquanto a referência existir (p.ex. entidade selecionada)
+    std::shared_ptr<const sf::Texture> acquireTexture() const;
+    const std::string& getTexturePath() const { return texturePath; }
     void setTextureRect(const sf::IntRect& rect) { sprite.setTextureRect(rect); }
 
     void setSelectedTileIndex(int index) { selectedTileIndex = index; }
@@ -38,10 +61,15 @@ public:
 
     bool hasSprite() const;
     sf::Vector2f getCollisionSize() const;
+    sf::Vector2f getFrameSize(int frame) const;
+
+    static bool parseDefinition(const std::string& filename, EntityDefinition& definition);
 
 private:
-    sf::Sprite sprite;
-    sf::Texture texture;
+    mutable sf::Sprite sprite;
+    TextureCache* textureCache = nullptr;
+    std::string texturePath;
+    sf::Vector2u textureSize;
     std::string name;
     std::vector<SpriteDefinition> spriteDefinitions;
     std::map<std::string, std::string> customData;
@@ -50,6 +78,8 @@ private:
 
     int selectedTileIndex = -1;
 
-    void loadTextureAtlas(const std::string& atlasPath, int cutX, int cutY);
-    void loadCustomData(const tinyxml2::XMLElement* entityElement);
+    void initialize(const EntityDefinition& definition, TextureCache& textureCache);
+    void buildSpriteCut(int cutX, int cutY);
+    static bool loadTextureAtlas(const std::string& atlasPath, std::vector<SpriteDefinition>& definitions);
+    static void loadCustomData(const tinyxml2::XMLElement* customDataElement, std::map<std::string, std::string>& values);
 };
\ No newline at end of file
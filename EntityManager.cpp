@@ -1,23 +1,194 @@
 #include "EntityManager.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
 #include <filesystem>
-#include <iostream>
 
 namespace fs = std::filesystem;
 
+EntityManager::EntityManager() {
+}
+
+EntityManager::~EntityManager() {
+    loaderPool.reset();
+}
+
 void EntityManager::loadEntitiesFromDirectory(const std::string& directory) {
+    beginLoadingFromDirectory(directory);
+
+    while (isLoading()) {
+        {
+            std::unique_lock<std::mutex> lock(completedMutex);
+            completedCondition.wait(lock, [this]() { return !completed.empty(); });
+        }
+        processPendingLoads(sf::Time::Zero);
+    }
+}
+
+void EntityManager::beginLoadingFromDirectory(const std::string& directory) {
+    if (!loaderPool) {
+        loaderPool = std::make_unique<ThreadPool>();
+    }
+    if (!metadataCache) {
+        metadataCache = std::make_unique<EntityMetadataCache>((fs::path(directory) / ".entity_cache").string());
+        metadataCache->load();
+    }
+
     for (const auto& entry : fs::directory_iterator(directory)) {
         if (entry.path().extension() == ".ent") {
-            try {
-                auto entity = std::make_unique<Entity>(entry.path().string());
-                std::string relativePath = fs::relative(entry.path(), directory).string();
-                entityPathMap[relativePath] = entity.get();
-                entities.push_back(std::move(entity));
-                std::cout << "Entidade carregada: " << relativePath << std::endl;
-            } catch (const std::exception& e) {
-                std::cerr << "Falha ao carregar entidade " << entry.path().string() << ": " << e.what() << std::endl;
-            }
+            std::string filename = entry.path().string();
+            std::string relativePath = fs::relative(entry.path(), directory).string();
+            ++queuedCount;
+
+            loaderPool->submit([this, filename, relativePath]() {
+                PROFILE_SCOPE("parseEntity");
+                auto result = std::make_unique<PendingEntity>();
+                result->filename = filename;
+                result->relativePath = relativePath;
+                result->parsed = metadataCache->lookup(result->filename, result->definition);
+                if (!result->parsed) {
+                    result->parsed = Entity::parseDefinition(result->filename, result->definition);
+                    if (result->parsed) {
+                        // Só as dimensões: a textura é carregada no primeiro uso
+                        if (!result->definition.texturePath.empty()) {
+                            TextureCache::readImageSize(result->definition.texturePath, result->definition.textureSize);
+                        }
+                        metadataCache->store(result->filename, result->definition);
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(completedMutex);
+                    completed.push_back(std::move(result));
+                }
+                completedCondition.notify_one();
+            });
+        }
+    }
+}
+
+std::size_t EntityManager::processPendingLoads(sf::Time budget) {
+    // Orçamento zero = processar tudo o que já estiver pronto
+    PROFILE_SCOPE("processPendingLoads");
+    sf::Clock clock;
+    std::size_t processed = 0;
+
+    std::vector<std::unique_ptr<PendingEntity>> ready;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        ready.swap(completed);
+    }
+
+    std::size_t index = 0;
+    for (; index < ready.size(); ++index) {
+        if (budget != sf::Time::Zero && processed > 0 && clock.getElapsedTime() >= budget) {
+            break;
+        }
+        finishEntity(*ready[index]);
+        ++processed;
+    }
+
+    // Devolve o que não coube neste quadro para a frente da fila
+    if (index < ready.size()) {
+        std::lock_guard<std::mutex> lock(completedMutex);
+        completed.insert(completed.begin(),
+                         std::make_move_iterator(ready.begin() + index),
+                         std::make_move_iterator(ready.end()));
+    }
+
+    // Terminado o carregamento, grava o cache de metadados para a próxima sessão
+    if (processed > 0 && !isLoading() && metadataCache) {
+        metadataCache->save();
+        LOG_INFO("Cache de metadados: " << metadataCache->getHitCount() << " reaproveitadas, "
+                 << metadataCache->getMissCount() << " reinterpretadas");
+    }
+
+    return processed;
+}
+
+void EntityManager::finishEntity(PendingEntity& pending) {
+    ++finishedCount;
+
+    if (!pending.parsed) {
+        LOG_ERROR("Falha ao carregar entidade " << pending.filename);
+        return;
+    }
+
+    auto entity = std::make_unique<Entity>(pending.definition, textureCache);
+    entityPathMap[pending.relativePath] = static_cast<PrototypeId>(entities.size());
+    entityPaths.push_back(pending.relativePath);
+    entities.push_back(std::move(entity));
+    LOG_DEBUG("Entidade carregada: " << pending.relativePath);
+}
+
+void EntityManager::prefetchTexture(PrototypeId id) {
+    const Entity* entity = getEntityById(id);
+    if (!entity || entity->getTexturePath().empty()) return;
+
+    const std::string& path = entity->getTexturePath();
+    if (textureCache.contains(path) || prefetchInFlight.count(path)) return;
+
+    if (!loaderPool) {
+        loaderPool = std::make_unique<ThreadPool>();
+    }
+    prefetchInFlight.insert(path);
+
+    loaderPool->submit([this, path]() {
+        PROFILE_SCOPE("decodeTexture");
+        auto result = std::make_unique<PrefetchedTexture>();
+        result->path = path;
+        result->image = std::make_unique<sf::Image>();
+        if (!result->image->loadFromFile(path)) {
+            result->image.reset();
+        }
+
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        prefetched.push_back(std::move(result));
+    });
+}
+
+std::size_t EntityManager::processPrefetchedTextures(sf::Time budget) {
+    PROFILE_SCOPE("uploadPrefetchedTextures");
+    sf::Clock clock;
+    std::size_t processed = 0;
+
+    std::vector<std::unique_ptr<PrefetchedTexture>> ready;
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        ready.swap(prefetched);
+    }
+
+    std::size_t index = 0;
+    for (; index < ready.size(); ++index) {
+        if (budget != sf::Time::Zero && processed > 0 && clock.getElapsedTime() >= budget) {
+            break;
+        }
+        PrefetchedTexture& texture = *ready[index];
+        prefetchInFlight.erase(texture.path);
+        if (texture.image) {
+            // Fica residente no cache como qualquer outra textura (sujeita ao LRU)
+            textureCache.acquire(texture.path, *texture.image);
         }
+        ++processed;
     }
+
+    if (index < ready.size()) {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        prefetched.insert(prefetched.begin(),
+                          std::make_move_iterator(ready.begin() + index),
+                          std::make_move_iterator(ready.end()));
+    }
+
+    return processed;
+}
+
+bool EntityManager::isTextureResident(PrototypeId id) const {
+    const Entity* entity = getEntityById(id);
+    return entity && (entity->getTexturePath().empty() || textureCache.contains(entity->getTexturePath()));
+}
+
+bool EntityManager::isTextureInFlight(PrototypeId id) const {
+    const Entity* entity = getEntityById(id);
+    return entity && prefetchInFlight.count(entity->getTexturePath()) > 0;
 }
 
 void EntityManager::drawEntities(sf::RenderWindow& window) const {
@@ -27,6 +198,10 @@ void EntityManager::drawEntities(sf::RenderWindow& window) const {
 }
 
 Entity* EntityManager::getEntityByPath(const std::string& path) {
+    return getEntityById(getEntityIdByPath(path));
+}
+
+PrototypeId EntityManager::getEntityIdByPath(const std::string& path) const {
     std::string adjustedPath = path;
     if (path.find("entities/") == 0) {
         adjustedPath = path.substr(9); // Remove "entities/" do início
@@ -35,5 +210,16 @@ Entity* EntityManager::getEntityByPath(const std::string& path) {
     if (it != entityPathMap.end()) {
         return it->second;
     }
-    return nullptr;
-}
\ No newline at end of file
+    return InvalidPrototypeId;
+}
+
+const std::string* EntityManager::getEntityPath(PrototypeId id) const {
+    return id < entityPaths.size() ? &entityPaths[id] : nullptr;
+}
+
+Entity* EntityManager::getEntityById(PrototypeId id) const {
+    if (id >= entities.size()) {
+        return nullptr;
+    }
+    return entities[id].get();
+}
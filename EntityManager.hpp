@@ -1,18 +1,89 @@
 #pragma once
 #include "Entity.hpp"
+#include "ThreadPool.hpp"
+#include "EntityMetadataCache.hpp"
 #include <vector>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_set>
+
+// Índice de um protótipo (entidade carregada) no EntityManager
+using PrototypeId = std::uint32_t;
+constexpr PrototypeId InvalidPrototypeId = static_cast<PrototypeId>(-1);
 
 class EntityManager {
 public:
+    EntityManager();
+    ~EntityManager();
+
     void loadEntitiesFromDirectory(const std::string& directory);
+
+    // Carregamento assíncrono: os XML são interpretados em threads de trabalho;
+    // processPendingLoads cria as entidades na thread principal, respeitando o
+    // orçamento de tempo de cada quadro. As texturas são carregadas sob demanda
+    // pelo TextureCache (ver setTextureBudget).
+    void beginLoadingFromDirectory(const std::string& directory);
+    std::size_t processPendingLoads(sf::Time budget);
+    bool isLoading() const { return finishedCount < queuedCount; }
+    std::size_t getFinishedCount() const { return finishedCount; }
+    std::size_t getQueuedCount() const { return queuedCount; }
+
+    // Pré-carregamento de texturas: a imagem é decodificada em segundo plano e
+    // processPrefetchedTextures a sobe para o TextureCache na thread principal
+    void prefetchTexture(PrototypeId id);
+    std::size_t processPrefetchedTextures(sf::Time budget);
+    bool isTextureResident(PrototypeId id) const;
+    bool isTextureInFlight(PrototypeId id) const;
+    bool hasPendingPrefetches() const { return !prefetchInFlight.empty(); }
+
     void drawEntities(sf::RenderWindow& window) const;
     const std::vector<std::unique_ptr<Entity>>& getEntities() const { return entities; }
     Entity* getEntityByPath(const std::string& path);
+    PrototypeId getEntityIdByPath(const std::string& path) const;
+    Entity* getEntityById(PrototypeId id) const;
+    // Caminho relativo ao diretório carregado: a chave que getEntityIdByPath resolve
+    const std::string* getEntityPath(PrototypeId id) const;
+    TextureCache& getTextureCache() { return textureCache; }
+    const TextureCache& getTextureCache() const { return textureCache; }
+    void setTextureBudget(std::size_t bytes) { textureCache.setBudget(bytes); }
 
 private:
+    struct PendingEntity {
+        std::string filename;
+        std::string relativePath;
+        bool parsed = false;
+        EntityDefinition definition;
+    };
+
+    struct PrefetchedTexture {
+        std::string path;
+        std::unique_ptr<sf::Image> image;
+    };
+
+    void finishEntity(PendingEntity& pending);
+
+    TextureCache textureCache;
     std::vector<std::unique_ptr<Entity>> entities;
-    std::unordered_map<std::string, Entity*> entityPathMap;
-};
\ No newline at end of file
+    std::unordered_map<std::string, PrototypeId> entityPathMap;
+    std::vector<std::string> entityPaths;  // Por PrototypeId, as chaves de entityPathMap
+
+    std::mutex completedMutex;
+    std::condition_variable completedCondition;
+    std::vector<std::unique_ptr<PendingEntity>> completed;
+    std::size_t queuedCount = 0;
+    std::size_t finishedCount = 0;
+
+    std::mutex prefetchMutex;
+    std::vector<std::unique_ptr<PrefetchedTexture>> prefetched;
+    std::unordered_set<std::string> prefetchInFlight;  // Só acessado na thread principal
+
+    // Definições já interpretadas em sessões anteriores (<diretório>/.entity_cache)
+    std::unique_ptr<EntityMetadataCache> metadataCache;
+
+    // Declarado por último: é destruído (e suas threads encerradas) primeiro
+    std::unique_ptr<ThreadPool> loaderPool;
+};
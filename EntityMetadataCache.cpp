@@ -0,0 +1,301 @@
+#include "EntityMetadataCache.hpp"
+#include "Log.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char CacheMagic[4] = {'E', 'M', 'C', 'H'};
+const std::uint32_t CacheVersion = 2;
+
+// Leitura com verificação de limites sobre o arquivo mapeado
+class Reader {
+public:
+    Reader(const char* data, std::size_t size, std::size_t offset) : data(data), size(size), offset(offset) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (offset + sizeof(T) > size) return false;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        std::uint32_t length = 0;
+        if (!read(length) || offset + length > size) return false;
+        value.assign(data + offset, length);
+        offset += length;
+        return true;
+    }
+
+    bool skipString() {
+        std::uint32_t length = 0;
+        if (!read(length) || offset + length > size) return false;
+        offset += length;
+        return true;
+    }
+
+    std::size_t position() const { return offset; }
+
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t offset;
+};
+
+class Writer {
+public:
+    explicit Writer(std::vector<char>& buffer) : buffer(buffer) {}
+
+    template <typename T>
+    void write(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void writeString(const std::string& value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+private:
+    std::vector<char>& buffer;
+};
+
+bool readDefinition(Reader& reader, EntityDefinition& definition) {
+    std::uint8_t hasAtlas = 0;
+    std::uint32_t spriteCount = 0;
+    if (!reader.readString(definition.name) || !reader.readString(definition.spritePath) ||
+        !reader.readString(definition.texturePath) || !reader.read(definition.cutX) ||
+        !reader.read(definition.cutY) || !reader.read(definition.textureSize.x) ||
+        !reader.read(definition.textureSize.y) || !reader.read(hasAtlas) || !reader.read(spriteCount)) {
+        return false;
+    }
+    definition.hasAtlas = hasAtlas != 0;
+
+    definition.spriteDefinitions.resize(spriteCount);
+    for (auto& sprite : definition.spriteDefinitions) {
+        if (!reader.readString(sprite.name) || !reader.read(sprite.rect.left) || !reader.read(sprite.rect.top) ||
+            !reader.read(sprite.rect.width) || !reader.read(sprite.rect.height)) {
+            return false;
+        }
+    }
+
+    std::uint32_t customCount = 0;
+    if (!reader.read(definition.collisionSize.x) || !reader.read(definition.collisionSize.y) || !reader.read(customCount)) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < customCount; ++i) {
+        std::string key, value;
+        if (!reader.readString(key) || !reader.readString(value)) return false;
+        definition.customData[key] = value;
+    }
+    return true;
+}
+
+void writeDefinition(Writer& writer, const EntityDefinition& definition) {
+    writer.writeString(definition.name);
+    writer.writeString(definition.spritePath);
+    writer.writeString(definition.texturePath);
+    writer.write(static_cast<std::int32_t>(definition.cutX));
+    writer.write(static_cast<std::int32_t>(definition.cutY));
+    writer.write(static_cast<std::uint32_t>(definition.textureSize.x));
+    writer.write(static_cast<std::uint32_t>(definition.textureSize.y));
+    writer.write(static_cast<std::uint8_t>(definition.hasAtlas ? 1 : 0));
+    writer.write(static_cast<std::uint32_t>(definition.spriteDefinitions.size()));
+    for (const auto& sprite : definition.spriteDefinitions) {
+        writer.writeString(sprite.name);
+        writer.write(static_cast<std::int32_t>(sprite.rect.left));
+        writer.write(static_cast<std::int32_t>(sprite.rect.top));
+        writer.write(static_cast<std::int32_t>(sprite.rect.width));
+        writer.write(static_cast<std::int32_t>(sprite.rect.height));
+    }
+    writer.write(definition.collisionSize.x);
+    writer.write(definition.collisionSize.y);
+    writer.write(static_cast<std::uint32_t>(definition.customData.size()));
+    for (const auto& entry : definition.customData) {
+        writer.writeString(entry.first);
+        writer.writeString(entry.second);
+    }
+}
+
+}
+
+EntityMetadataCache::EntityMetadataCache(const std::string& cachePath) : cachePath(cachePath) {
+}
+
+EntityMetadataCache::FileStamp EntityMetadataCache::stampOf(const std::string& path) {
+    FileStamp stamp;
+    std::error_code ec;
+    auto size = fs::file_size(path, ec);
+    if (ec) return stamp;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec) return stamp;
+
+    stamp.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    stamp.size = static_cast<std::uint64_t>(size);
+    return stamp;
+}
+
+std::string EntityMetadataCache::atlasPathFor(const EntityDefinition& definition) {
+    if (definition.texturePath.empty()) return std::string();
+    return definition.texturePath.substr(0, definition.texturePath.find_last_of('.')) + ".xml";
+}
+
+bool EntityMetadataCache::load() {
+    mappedEntries.clear();
+    if (!mappedFile.open(cachePath)) {
+        return false;
+    }
+
+    const char* data = mappedFile.data();
+    std::size_t size = mappedFile.size();
+    Reader reader(data, size, 0);
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t entryCount = 0;
+    if (size < sizeof(magic) || std::memcmp(data, CacheMagic, sizeof(magic)) != 0) {
+        LOG_WARNING("Cache de metadados inválido, ignorado: " << cachePath);
+        mappedFile.close();
+        return false;
+    }
+    reader.read(magic);
+    if (!reader.read(version) || version != CacheVersion || !reader.read(entryCount)) {
+        mappedFile.close();
+        return false;
+    }
+
+    // Indexa as entradas sem decodificar as definições
+    for (std::uint32_t i = 0; i < entryCount; ++i) {
+        std::string path;
+        std::uint32_t entryLength = 0;
+        MappedEntry entry;
+        if (!reader.readString(path) || !reader.read(entry.entStamp.mtime) || !reader.read(entry.entStamp.size) ||
+            !reader.read(entry.atlasStamp.mtime) || !reader.read(entry.atlasStamp.size) ||
+            !reader.read(entry.textureStamp.mtime) || !reader.read(entry.textureStamp.size) || !reader.read(entryLength)) {
+            LOG_WARNING("Cache de metadados truncado: " << cachePath);
+            mappedEntries.clear();
+            mappedFile.close();
+            return false;
+        }
+        entry.offset = reader.position();
+        entry.end = entry.offset + entryLength;
+        if (entry.end > size) {
+            mappedEntries.clear();
+            mappedFile.close();
+            return false;
+        }
+        mappedEntries[path] = entry;
+        reader = Reader(data, size, entry.end);
+    }
+    return true;
+}
+
+bool EntityMetadataCache::lookup(const std::string& entPath, EntityDefinition& definition) {
+    auto it = mappedEntries.find(entPath);
+    if (it == mappedEntries.end() || !(stampOf(entPath) == it->second.entStamp)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++missCount;
+        return false;
+    }
+
+    const MappedEntry& entry = it->second;
+    Reader reader(mappedFile.data(), entry.end, entry.offset);
+    EntityDefinition cached;
+    if (!readDefinition(reader, cached) || !(stampOf(atlasPathFor(cached)) == entry.atlasStamp) ||
+        !(stampOf(cached.texturePath) == entry.textureStamp)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++missCount;
+        return false;
+    }
+
+    definition = std::move(cached);
+
+    // Reaproveita os bytes da entrada válida no próximo save
+    std::vector<char> raw;
+    Writer writer(raw);
+    writer.writeString(entPath);
+    writer.write(entry.entStamp.mtime);
+    writer.write(entry.entStamp.size);
+    writer.write(entry.atlasStamp.mtime);
+    writer.write(entry.atlasStamp.size);
+    writer.write(entry.textureStamp.mtime);
+    writer.write(entry.textureStamp.size);
+    writer.write(static_cast<std::uint32_t>(entry.end - entry.offset));
+    raw.insert(raw.end(), mappedFile.data() + entry.offset, mappedFile.data() + entry.end);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entriesToSave[entPath] = std::move(raw);
+    ++hitCount;
+    return true;
+}
+
+void EntityMetadataCache::store(const std::string& entPath, const EntityDefinition& definition) {
+    std::vector<char> body;
+    Writer bodyWriter(body);
+    writeDefinition(bodyWriter, definition);
+
+    FileStamp entStamp = stampOf(entPath);
+    FileStamp atlasStamp = stampOf(atlasPathFor(definition));
+    FileStamp textureStamp = stampOf(definition.texturePath);
+
+    std::vector<char> raw;
+    Writer writer(raw);
+    writer.writeString(entPath);
+    writer.write(entStamp.mtime);
+    writer.write(entStamp.size);
+    writer.write(atlasStamp.mtime);
+    writer.write(atlasStamp.size);
+    writer.write(textureStamp.mtime);
+    writer.write(textureStamp.size);
+    writer.write(static_cast<std::uint32_t>(body.size()));
+    raw.insert(raw.end(), body.begin(), body.end());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entriesToSave[entPath] = std::move(raw);
+    dirty = true;
+}
+
+bool EntityMetadataCache::save() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Nada mudou e nenhuma entrada antiga foi descartada
+    if (!dirty && entriesToSave.size() == mappedEntries.size()) {
+        return true;
+    }
+
+    // Grava em um arquivo temporário e troca de uma vez, para nunca deixar um cache pela metade
+    std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOG_ERROR("Não foi possível gravar o cache de metadados: " << tempPath);
+            return false;
+        }
+        std::uint32_t version = CacheVersion;
+        std::uint32_t entryCount = static_cast<std::uint32_t>(entriesToSave.size());
+        out.write(CacheMagic, sizeof(CacheMagic));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&entryCount), sizeof(entryCount));
+        for (const auto& entry : entriesToSave) {
+            out.write(entry.second.data(), entry.second.size());
+        }
+        if (!out.flush()) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        LOG_ERROR("Não foi possível substituir o cache de metadados: " << ec.message());
+        return false;
+    }
+    dirty = false;
+    return true;
+}
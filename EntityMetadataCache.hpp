@@ -0,0 +1,55 @@
+#pragma once
+#include "Entity.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Cache binário persistente das EntityDefinition já interpretadas.
+// Cada entrada é indexada pelo caminho do .ent e validada pelo mtime e tamanho
+// do .ent, do atlas XML e da imagem correspondentes; só arquivos alterados são reinterpretados.
+// O arquivo é mapeado em memória e as entradas são decodificadas sob demanda.
+// lookup e store podem ser chamados de várias threads.
+class EntityMetadataCache {
+public:
+    explicit EntityMetadataCache(const std::string& cachePath);
+
+    bool load();
+    bool lookup(const std::string& entPath, EntityDefinition& definition);
+    void store(const std::string& entPath, const EntityDefinition& definition);
+    bool save();
+
+    std::size_t getHitCount() const { return hitCount; }
+    std::size_t getMissCount() const { return missCount; }
+
+private:
+    struct FileStamp {
+        std::int64_t mtime = -1;  // -1 = arquivo inexistente
+        std::uint64_t size = 0;
+
+        bool operator==(const FileStamp& other) const { return mtime == other.mtime && size == other.size; }
+    };
+
+    struct MappedEntry {
+        std::size_t offset;  // Início dos dados da definição no arquivo mapeado
+        std::size_t end;     // Fim da entrada
+        FileStamp entStamp;
+        FileStamp atlasStamp;
+        FileStamp textureStamp;  // As dimensões da textura também ficam no cache
+    };
+
+    static FileStamp stampOf(const std::string& path);
+    static std::string atlasPathFor(const EntityDefinition& definition);
+
+    std::string cachePath;
+    MappedFile mappedFile;
+    std::unordered_map<std::string, MappedEntry> mappedEntries;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<char>> entriesToSave;  // Entradas serializadas válidas nesta sessão
+    bool dirty = false;
+    std::size_t hitCount = 0;
+    std::size_t missCount = 0;
+};
@@ -0,0 +1,50 @@
+#include "GridRenderer.hpp"
+#include <cmath>
+
+GridRenderer::GridRenderer() : buffer(sf::Lines, sf::VertexBuffer::Static) {
+}
+
+void GridRenderer::draw(sf::RenderTarget& target, const sf::FloatRect& visibleArea, sf::Vector2f cellSize, sf::Color color) {
+    if (cellSize.x <= 0 || cellSize.y <= 0) return;
+
+    // Uma célula extra em cada eixo cobre o deslocamento dentro da primeira célula
+    sf::Vector2u cells(static_cast<unsigned>(std::ceil(visibleArea.width / cellSize.x)) + 1,
+                       static_cast<unsigned>(std::ceil(visibleArea.height / cellSize.y)) + 1);
+    if (vertices.empty() || cells != builtCells || cellSize != builtCellSize || color != builtColor) {
+        rebuild(cells, cellSize, color);
+    }
+
+    sf::RenderStates states;
+    states.transform.translate(std::floor(visibleArea.left / cellSize.x) * cellSize.x,
+                               std::floor(visibleArea.top / cellSize.y) * cellSize.y);
+    if (buffer.getVertexCount() == vertices.size()) {
+        target.draw(buffer, states);
+    } else {
+        target.draw(vertices.data(), vertices.size(), sf::Lines, states);
+    }
+}
+
+void GridRenderer::rebuild(sf::Vector2u cells, sf::Vector2f cellSize, sf::Color color) {
+    builtCells = cells;
+    builtCellSize = cellSize;
+    builtColor = color;
+
+    const float width = cells.x * cellSize.x;
+    const float height = cells.y * cellSize.y;
+
+    vertices.clear();
+    vertices.reserve((cells.x + cells.y + 2) * 2);
+    for (unsigned x = 0; x <= cells.x; ++x) {
+        vertices.emplace_back(sf::Vector2f(x * cellSize.x, 0), color);
+        vertices.emplace_back(sf::Vector2f(x * cellSize.x, height), color);
+    }
+    for (unsigned y = 0; y <= cells.y; ++y) {
+        vertices.emplace_back(sf::Vector2f(0, y * cellSize.y), color);
+        vertices.emplace_back(sf::Vector2f(width, y * cellSize.y), color);
+    }
+
+    if (sf::VertexBuffer::isAvailable() && buffer.create(vertices.size()) && buffer.update(vertices.data())) {
+        return;
+    }
+    buffer.create(0);
+}
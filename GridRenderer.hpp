@@ -0,0 +1,25 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Grade infinita desenhada a partir de um sf::VertexBuffer estático.
+// As linhas são geradas uma vez, em coordenadas locais, cobrindo a área
+// visível mais uma célula; como a grade é periódica, basta transladá-las
+// para a célula do canto da câmera a cada quadro. Só é regerada quando o
+// tamanho da célula, a cor ou o número de células visíveis (zoom, tamanho
+// da janela) mudam.
+class GridRenderer {
+public:
+    GridRenderer();
+
+    void draw(sf::RenderTarget& target, const sf::FloatRect& visibleArea, sf::Vector2f cellSize, sf::Color color);
+
+private:
+    void rebuild(sf::Vector2u cells, sf::Vector2f cellSize, sf::Color color);
+
+    sf::VertexBuffer buffer;
+    std::vector<sf::Vertex> vertices;  // Usado direto se não houver suporte a VertexBuffer
+    sf::Vector2u builtCells;
+    sf::Vector2f builtCellSize;
+    sf::Color builtColor;
+};
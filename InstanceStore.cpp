@@ -0,0 +1,287 @@
+#include "InstanceStore.hpp"
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace {
+
+const std::uint32_t StoreFormatVersion = 2;
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void writeString(std::ostream& out, const std::string& value) {
+    writeValue(out, static_cast<std::uint32_t>(value.size()));
+    out.write(value.data(), value.size());
+}
+
+bool readString(std::istream& in, std::string& value) {
+    std::uint32_t length = 0;
+    if (!readValue(in, length)) return false;
+    value.resize(length);
+    return length == 0 || static_cast<bool>(in.read(&value[0], length));
+}
+
+}
+
+InstanceStore::InstanceStore() : data(std::make_shared<InstanceData>()) {
+    // Slot 0 é reservado para "sem sobrescrita"
+    data->overrides.emplace_back();
+}
+
+InstanceData& InstanceStore::mutableData() {
+    if (data.use_count() > 1) {
+        data = std::make_shared<InstanceData>(*data);
+    }
+    return *data;
+}
+
+std::size_t InstanceStore::add(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame,
+                               std::uint32_t sequence) {
+    PlacedInstance instance;
+    instance.prototypeId = prototypeId;
+    instance.x = position.x;
+    instance.y = position.y;
+    instance.spriteFrame = spriteFrame;
+    instance.overrideSlot = NoOverride;
+    instance.sequence = sequence;
+    std::vector<PlacedInstance>& instances = mutableData().instances;
+    instances.push_back(instance);
+    ++revision;
+
+    std::size_t index = instances.size() - 1;
+    spatialIndex.insert(static_cast<std::uint32_t>(index), sf::FloatRect(position, size));
+    occupyAnchor(index);
+    return index;
+}
+
+void InstanceStore::remove(std::size_t index) {
+    if (index >= size()) return;
+
+    releaseOverride(data->instances[index].overrideSlot);
+
+    std::vector<PlacedInstance>& instances = mutableData().instances;
+    std::size_t last = instances.size() - 1;
+    vacateAnchor(index);
+    spatialIndex.remove(static_cast<std::uint32_t>(index));
+    bool movedWasOnTop = false;
+    if (index != last) {
+        spatialIndex.relabel(static_cast<std::uint32_t>(last), static_cast<std::uint32_t>(index));
+        auto it = anchorOccupants.find(makeAnchorKey(instances[last].x, instances[last].y));
+        movedWasOnTop = it != anchorOccupants.end() && it->second == last;
+    }
+
+    instances[index] = instances.back();
+    instances.pop_back();
+    ++revision;
+
+    if (movedWasOnTop) {
+        // O último elemento desceu para `index`; outra instância na mesma
+        // âncora pode ter ficado por cima dele
+        electAnchorOccupant(sf::Vector2f(instances[index].x, instances[index].y), size());
+    }
+}
+
+void InstanceStore::clear() {
+    if (data.use_count() > 1) {
+        // Um snapshot ainda usa os dados antigos; não há o que copiar
+        data = std::make_shared<InstanceData>();
+        data->overrides.emplace_back();
+    } else {
+        data->instances.clear();
+        data->overrides.resize(1);
+    }
+    freeOverrideSlots.clear();
+    spatialIndex.clear();
+    anchorOccupants.clear();
+    ++revision;
+}
+
+void InstanceStore::setPosition(std::size_t index, sf::Vector2f position) {
+    vacateAnchor(index);
+    PlacedInstance& instance = mutableData().instances[index];
+    instance.x = position.x;
+    instance.y = position.y;
+    ++revision;
+
+    sf::FloatRect bounds = spatialIndex.getBounds(static_cast<std::uint32_t>(index));
+    spatialIndex.update(static_cast<std::uint32_t>(index), sf::FloatRect(position.x, position.y, bounds.width, bounds.height));
+    occupyAnchor(index);
+}
+
+void InstanceStore::setSpriteFrame(std::size_t index, int spriteFrame, sf::Vector2f size) {
+    PlacedInstance& instance = mutableData().instances[index];
+    instance.spriteFrame = spriteFrame;
+    ++revision;
+
+    spatialIndex.update(static_cast<std::uint32_t>(index), sf::FloatRect(sf::Vector2f(instance.x, instance.y), size));
+}
+
+void InstanceStore::setOverride(std::size_t index, const std::string& key, const std::string& value) {
+    InstanceData& values = mutableData();
+    PlacedInstance& instance = values.instances[index];
+    if (instance.overrideSlot == NoOverride) {
+        if (!freeOverrideSlots.empty()) {
+            instance.overrideSlot = freeOverrideSlots.back();
+            freeOverrideSlots.pop_back();
+        } else {
+            instance.overrideSlot = static_cast<std::uint32_t>(values.overrides.size());
+            values.overrides.emplace_back();
+        }
+    }
+    values.overrides[instance.overrideSlot][key] = value;
+}
+
+bool InstanceStore::findAnchoredAt(sf::Vector2f position, std::size_t& index) const {
+    auto it = anchorOccupants.find(makeAnchorKey(position.x, position.y));
+    if (it == anchorOccupants.end()) return false;
+    index = it->second;
+    return true;
+}
+
+InstanceStore::AnchorKey InstanceStore::makeAnchorKey(float x, float y) {
+    // Chave pelos bits exatos da posição (-0 e 0 são a mesma âncora)
+    x += 0.0f;
+    y += 0.0f;
+    std::uint32_t bitsX, bitsY;
+    std::memcpy(&bitsX, &x, sizeof(bitsX));
+    std::memcpy(&bitsY, &y, sizeof(bitsY));
+    return (static_cast<AnchorKey>(bitsX) << 32) | bitsY;
+}
+
+void InstanceStore::occupyAnchor(std::size_t index) {
+    const PlacedInstance& instance = data->instances[index];
+    auto result = anchorOccupants.emplace(makeAnchorKey(instance.x, instance.y), static_cast<std::uint32_t>(index));
+    if (!result.second && result.first->second < index) {
+        result.first->second = static_cast<std::uint32_t>(index);
+    }
+}
+
+void InstanceStore::vacateAnchor(std::size_t index) {
+    const PlacedInstance& instance = data->instances[index];
+    auto it = anchorOccupants.find(makeAnchorKey(instance.x, instance.y));
+    if (it != anchorOccupants.end() && it->second == index) {
+        electAnchorOccupant(sf::Vector2f(instance.x, instance.y), index);
+    }
+}
+
+void InstanceStore::electAnchorOccupant(sf::Vector2f anchor, std::size_t ignoredIndex) {
+    // Instâncias empilhadas (cenas antigas ou importadas): a do topo é achada
+    // pelo índice espacial, só entre as que cobrem a âncora
+    std::vector<std::uint32_t> candidates;
+    spatialIndex.queryPoint(anchor, candidates);
+    bool found = false;
+    std::uint32_t top = 0;
+    for (std::uint32_t candidate : candidates) {
+        const PlacedInstance& other = data->instances[candidate];
+        if (candidate != ignoredIndex && other.x == anchor.x && other.y == anchor.y && (!found || candidate > top)) {
+            top = candidate;
+            found = true;
+        }
+    }
+
+    AnchorKey key = makeAnchorKey(anchor.x, anchor.y);
+    if (found) {
+        anchorOccupants[key] = top;
+    } else {
+        anchorOccupants.erase(key);
+    }
+}
+
+void InstanceStore::releaseOverride(std::uint32_t slot) {
+    if (slot == NoOverride) return;
+    mutableData().overrides[slot].clear();
+    freeOverrideSlots.push_back(slot);
+}
+
+bool InstanceStore::writeTo(std::ostream& out) const {
+    const std::vector<PlacedInstance>& instances = data->instances;
+    writeValue(out, StoreFormatVersion);
+    writeValue(out, static_cast<std::uint32_t>(instances.size()));
+
+    std::uint32_t overrideCount = 0;
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        const PlacedInstance& instance = instances[i];
+        sf::FloatRect bounds = getBounds(i);
+        writeValue(out, instance.prototypeId);
+        writeValue(out, instance.x);
+        writeValue(out, instance.y);
+        writeValue(out, instance.spriteFrame);
+        writeValue(out, bounds.width);
+        writeValue(out, bounds.height);
+        writeValue(out, instance.sequence);
+        if (instance.overrideSlot != NoOverride) {
+            ++overrideCount;
+        }
+    }
+
+    writeValue(out, overrideCount);
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        if (instances[i].overrideSlot == NoOverride) continue;
+
+        const auto& values = data->overrides[instances[i].overrideSlot];
+        writeValue(out, static_cast<std::uint32_t>(i));
+        writeValue(out, static_cast<std::uint32_t>(values.size()));
+        for (const auto& entry : values) {
+            writeString(out, entry.first);
+            writeString(out, entry.second);
+        }
+    }
+
+    return static_cast<bool>(out);
+}
+
+bool InstanceStore::readFrom(std::istream& in) {
+    clear();
+
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    if (!readValue(in, version) || version != StoreFormatVersion || !readValue(in, count)) {
+        return false;
+    }
+
+    reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        PrototypeId prototypeId;
+        float x, y, width, height;
+        std::int32_t spriteFrame;
+        std::uint32_t sequence;
+        if (!readValue(in, prototypeId) || !readValue(in, x) || !readValue(in, y) ||
+            !readValue(in, spriteFrame) || !readValue(in, width) || !readValue(in, height) ||
+            !readValue(in, sequence)) {
+            clear();
+            return false;
+        }
+        add(prototypeId, sf::Vector2f(x, y), sf::Vector2f(width, height), spriteFrame, sequence);
+    }
+
+    std::uint32_t overrideCount = 0;
+    if (!readValue(in, overrideCount)) {
+        clear();
+        return false;
+    }
+    for (std::uint32_t i = 0; i < overrideCount; ++i) {
+        std::uint32_t index, valueCount;
+        if (!readValue(in, index) || !readValue(in, valueCount) || index >= size()) {
+            clear();
+            return false;
+        }
+        for (std::uint32_t v = 0; v < valueCount; ++v) {
+            std::string key, value;
+            if (!readString(in, key) || !readString(in, value)) {
+                clear();
+                return false;
+            }
+            setOverride(index, key, value);
+        }
+    }
+
+    return true;
+}
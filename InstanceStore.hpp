@@ -0,0 +1,105 @@
+#pragma once
+#include "EntityManager.hpp"
+#include "SpatialHash.hpp"
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Registro compacto de uma entidade colocada na cena.
+// Guarda apenas uma referência ao protótipo no EntityManager; nome, sprite,
+// textura e CustomData continuam no protótipo.
+struct PlacedInstance {
+    PrototypeId prototypeId;
+    float x;
+    float y;
+    std::int32_t spriteFrame;
+    std::uint32_t overrideSlot;  // 0 = sem sobrescrita de CustomData
+    std::uint32_t sequence;      // Ordem de inserção na cena (ordem e ids da exportação)
+};
+
+// Registros e sobrescritas de um InstanceStore. Compartilhado com snapshots
+// (copy-on-write): o InstanceStore só copia os dados ao alterá-los enquanto
+// algum snapshot ainda os referencia.
+struct InstanceData {
+    std::vector<PlacedInstance> instances;
+    std::vector<std::map<std::string, std::string>> overrides;  // Slot 0 = sem sobrescrita
+
+    const std::map<std::string, std::string>* getOverrides(std::size_t index) const {
+        std::uint32_t slot = instances[index].overrideSlot;
+        return slot == 0 ? nullptr : &overrides[slot];
+    }
+};
+
+// Armazenamento contíguo das instâncias colocadas (vetor de PODs).
+// A remoção troca o último elemento para a posição removida.
+// Mantém um SpatialHash sincronizado, indexado pela posição no vetor, e um
+// mapa de ocupação: posição de ancoragem (canto da célula) -> instância do topo.
+class InstanceStore {
+public:
+    static constexpr std::uint32_t NoOverride = 0;
+
+    InstanceStore();
+
+    std::size_t add(PrototypeId prototypeId, sf::Vector2f position, sf::Vector2f size, int spriteFrame,
+                    std::uint32_t sequence);
+    void remove(std::size_t index);
+    void clear();
+    void reserve(std::size_t count) { mutableData().instances.reserve(count); }
+
+    std::size_t size() const { return data->instances.size(); }
+    bool empty() const { return data->instances.empty(); }
+    const PlacedInstance& operator[](std::size_t index) const { return data->instances[index]; }
+    const std::vector<PlacedInstance>& getInstances() const { return data->instances; }
+    std::vector<PlacedInstance>::const_iterator begin() const { return data->instances.begin(); }
+    std::vector<PlacedInstance>::const_iterator end() const { return data->instances.end(); }
+
+    // Snapshot O(1) dos registros; a próxima alteração copia os dados
+    std::shared_ptr<const InstanceData> share() const { return data; }
+
+    // Incrementada a cada alteração que afeta a renderização
+    std::uint64_t getRevision() const { return revision; }
+
+    void setPosition(std::size_t index, sf::Vector2f position);
+    void setSpriteFrame(std::size_t index, int spriteFrame, sf::Vector2f size);
+
+    // Consultas espaciais (retornam índices de instâncias)
+    void setCellSize(float cellSize) { spatialIndex.setCellSize(cellSize); }
+    sf::FloatRect getBounds(std::size_t index) const { return spatialIndex.getBounds(static_cast<std::uint32_t>(index)); }
+    void queryPoint(sf::Vector2f point, std::vector<std::uint32_t>& out) const { spatialIndex.queryPoint(point, out); }
+    void queryRect(const sf::FloatRect& rect, std::vector<std::uint32_t>& out) const { spatialIndex.queryRect(rect, out); }
+    void queryNearest(sf::Vector2f point, std::size_t count, std::vector<std::uint32_t>& out) const { spatialIndex.queryNearest(point, count, out); }
+
+    // Instância do topo ancorada exatamente em `position`, em O(1)
+    bool findAnchoredAt(sf::Vector2f position, std::size_t& index) const;
+
+    // Sobrescritas de CustomData por instância
+    void setOverride(std::size_t index, const std::string& key, const std::string& value);
+    const std::map<std::string, std::string>* getOverrides(std::size_t index) const { return data->getOverrides(index); }
+
+    // Serialização binária (registros, tamanhos e sobrescritas)
+    bool writeTo(std::ostream& out) const;
+    bool readFrom(std::istream& in);
+
+private:
+    InstanceData& mutableData();
+
+    using AnchorKey = std::uint64_t;
+
+    std::shared_ptr<InstanceData> data;
+    std::vector<std::uint32_t> freeOverrideSlots;
+    SpatialHash spatialIndex;
+    // Posição de ancoragem -> maior índice ancorado nela (o desenhado por cima)
+    std::unordered_map<AnchorKey, std::uint32_t> anchorOccupants;
+    std::uint64_t revision = 0;
+
+    void releaseOverride(std::uint32_t slot);
+    static AnchorKey makeAnchorKey(float x, float y);
+    void occupyAnchor(std::size_t index);
+    void vacateAnchor(std::size_t index);
+    void electAnchorOccupant(sf::Vector2f anchor, std::size_t ignoredIndex);
+};
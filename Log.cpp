@@ -0,0 +1,177 @@
+#include "Log.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+const std::chrono::milliseconds DrainInterval(5);
+
+bool applyEnvironmentLevel() {
+    LogLevel level;
+    if (const char* name = std::getenv("EDITOR_LOG_LEVEL")) {
+        if (Log::parseLevel(name, level)) {
+            Log::setLevel(level);
+        } else {
+            std::cerr << "EDITOR_LOG_LEVEL desconhecido: " << name << std::endl;
+        }
+    }
+    return true;
+}
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warning: return "aviso";
+        case LogLevel::Error: return "erro";
+        default: return "";
+    }
+}
+
+}
+
+// Inicializado em tempo de compilação: vale mesmo para quem registra durante a
+// inicialização estática, antes de a variável de ambiente ser lida
+std::atomic<int> Log::runtimeLevel{static_cast<int>(LogLevel::Info)};
+std::atomic<bool> Log::stdoutAllowed{true};
+
+namespace {
+const bool environmentLevelApplied = applyEnvironmentLevel();
+}
+
+void Log::setLevel(LogLevel level) {
+    runtimeLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Log::getLevel() {
+    return static_cast<LogLevel>(runtimeLevel.load(std::memory_order_relaxed));
+}
+
+bool Log::parseLevel(const std::string& name, LogLevel& level) {
+    if (name == "debug") level = LogLevel::Debug;
+    else if (name == "info") level = LogLevel::Info;
+    else if (name == "warning") level = LogLevel::Warning;
+    else if (name == "error") level = LogLevel::Error;
+    else if (name == "off") level = LogLevel::Off;
+    else return false;
+    return true;
+}
+
+void Log::write(LogLevel level, std::string message) {
+    writer().push(level, message);
+}
+
+void Log::flush() {
+    writer().flush();
+}
+
+Log::Writer& Log::writer() {
+    static Writer instance;
+    return instance;
+}
+
+Log::Writer::Writer()
+    : slots(new Slot[QueueCapacity]), origin(std::chrono::steady_clock::now()) {
+    for (std::size_t i = 0; i < QueueCapacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    thread = std::thread(&Writer::writerLoop, this);
+}
+
+Log::Writer::~Writer() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool Log::Writer::push(LogLevel level, std::string& message) {
+    // Fila limitada de múltiplos produtores (Vyukov): cada posição tem um número
+    // de sequência que diz se está livre para a volta atual do buffer
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[position & (QueueCapacity - 1)];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Fila cheia: avisos e erros esperam a thread de fundo abrir espaço,
+            // o resto é descartado para não segurar quem registra
+            if (level < LogLevel::Warning || !running.load(std::memory_order_relaxed)) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::this_thread::yield();
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->time = std::chrono::steady_clock::now();
+    slot->text = std::move(message);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+void Log::Writer::flush() {
+    const std::size_t target = enqueuePosition.load(std::memory_order_acquire);
+    while (writtenCount.load(std::memory_order_acquire) < target &&
+           running.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+std::size_t Log::Writer::drain() {
+    std::size_t written = 0;
+    bool wroteError = false;
+    for (;;) {
+        Slot& slot = slots[dequeuePosition & (QueueCapacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            break;
+        }
+
+        float seconds = std::chrono::duration<float>(slot.time - origin).count();
+        std::FILE* stream = slot.level >= LogLevel::Warning || !stdoutAllowed.load(std::memory_order_relaxed)
+                                ? stderr : stdout;
+        std::fprintf(stream, "[%9.3f] %s: %s\n", seconds, levelName(slot.level), slot.text.c_str());
+        wroteError = wroteError || stream == stderr;
+
+        slot.text.clear();
+        slot.sequence.store(dequeuePosition + QueueCapacity, std::memory_order_release);
+        ++dequeuePosition;
+        ++written;
+    }
+
+    // Uma descarga por lote, não por linha
+    if (written > 0) {
+        std::fflush(stdout);
+        if (wroteError) std::fflush(stderr);
+        writtenCount.fetch_add(written, std::memory_order_release);
+    }
+    return written;
+}
+
+void Log::Writer::writerLoop() {
+    std::size_t reportedDrops = 0;
+    while (running.load(std::memory_order_relaxed)) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(DrainInterval);
+        }
+
+        std::size_t dropped = droppedCount.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops) {
+            std::fprintf(stderr, "%zu mensagens de log descartadas (fila cheia)\n", dropped - reportedDrops);
+            reportedDrops = dropped;
+        }
+    }
+    // Ao encerrar, escreve o que ainda estiver na fila
+    drain();
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+enum class LogLevel : int {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+    Off = 4
+};
+
+// Nível mínimo compilado: mensagens abaixo dele somem do binário.
+// Ex.: -DEDITOR_LOG_MIN_LEVEL=1 remove todos os LOG_DEBUG.
+#ifndef EDITOR_LOG_MIN_LEVEL
+#define EDITOR_LOG_MIN_LEVEL 0
+#endif
+
+// Log assíncrono: quem registra só formata a mensagem e a coloca num buffer
+// circular sem trava; uma thread de fundo escreve em stdout/stderr.
+// Com o buffer cheio, mensagens abaixo de Warning são descartadas (e contadas)
+// em vez de bloquear.
+// O nível em tempo de execução começa em Info ou no valor da variável de
+// ambiente EDITOR_LOG_LEVEL (debug, info, warning, error, off).
+class Log {
+public:
+    static constexpr std::size_t QueueCapacity = 8192;  // Potência de dois
+
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level);
+    static LogLevel getLevel();
+
+    static void write(LogLevel level, std::string message);
+    // Espera a thread de fundo escrever tudo o que já foi registrado
+    static void flush();
+
+    static bool parseLevel(const std::string& name, LogLevel& level);
+
+    // false = tudo vai para stderr, deixando stdout só para a saída de dados
+    static void setStdoutAllowed(bool allowed) { stdoutAllowed.store(allowed, std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};
+        LogLevel level = LogLevel::Info;
+        std::chrono::steady_clock::time_point time;
+        std::string text;
+    };
+
+    class Writer {
+    public:
+        Writer();
+        ~Writer();
+
+        bool push(LogLevel level, std::string& message);
+        void flush();
+
+    private:
+        void writerLoop();
+        std::size_t drain();
+
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::size_t> enqueuePosition{0};
+        std::size_t dequeuePosition = 0;  // Só a thread de fundo mexe
+        std::atomic<std::size_t> writtenCount{0};
+        std::atomic<std::size_t> droppedCount{0};
+        std::atomic<bool> running{true};
+        std::chrono::steady_clock::time_point origin;
+        std::thread thread;
+    };
+
+    static Writer& writer();
+    static std::atomic<int> runtimeLevel;
+    static std::atomic<bool> stdoutAllowed;
+};
+
+// A mensagem aceita encadeamento como em std::cout: LOG_INFO("Cena salva em " << filename);
+// Ela só é formatada quando o nível está ativo.
+#define EDITOR_LOG(level, message)                                                        \
+    do {                                                                                  \
+        if (static_cast<int>(level) >= EDITOR_LOG_MIN_LEVEL && Log::isEnabled(level)) {   \
+            std::ostringstream editorLogStream;                                           \
+            editorLogStream << message;                                                   \
+            Log::write(level, editorLogStream.str());                                     \
+        }                                                                                 \
+    } while (0)
+
+#define LOG_DEBUG(message) EDITOR_LOG(LogLevel::Debug, message)
+#define LOG_INFO(message) EDITOR_LOG(LogLevel::Info, message)
+#define LOG_WARNING(message) EDITOR_LOG(LogLevel::Warning, message)
+#define LOG_ERROR(message) EDITOR_LOG(LogLevel::Error, message)
@@ -0,0 +1,50 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fileDescriptor, &info) != 0) {
+        close();
+        return false;
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+    if (length == 0) {
+        // mmap não aceita tamanho zero; um arquivo vazio é válido, só não tem dados
+        return true;
+    }
+
+    mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapped == MAP_FAILED) {
+        mapped = nullptr;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped) {
+        munmap(mapped, length);
+        mapped = nullptr;
+    }
+    if (fileDescriptor >= 0) {
+        ::close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+    length = 0;
+}
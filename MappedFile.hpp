@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Arquivo somente leitura mapeado em memória (mmap).
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return mapped != nullptr || (fileDescriptor >= 0 && length == 0); }
+    const char* data() const { return static_cast<const char*>(mapped); }
+    std::size_t size() const { return length; }
+
+private:
+    int fileDescriptor = -1;
+    void* mapped = nullptr;
+    std::size_t length = 0;
+};
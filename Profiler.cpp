@@ -0,0 +1,102 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <fstream>
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : origin(Clock::now()) {
+}
+
+void Profiler::setEnabled(bool enable) {
+    if (enable) {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        if (events.empty()) events.resize(EventCapacity);
+    }
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+std::uint32_t Profiler::currentThreadId() {
+    static std::atomic<std::uint32_t> nextId{1};
+    thread_local std::uint32_t id = nextId++;
+    return id;
+}
+
+std::int64_t Profiler::toMicroseconds(Clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - origin).count();
+}
+
+void Profiler::record(const char* name, Clock::time_point begin, Clock::time_point end) {
+    Event event{name, currentThreadId(), toMicroseconds(begin),
+                std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count()};
+
+    std::lock_guard<std::mutex> lock(eventMutex);
+    if (events.empty()) return;
+    events[nextEvent] = event;
+    if (++nextEvent == events.size()) {
+        nextEvent = 0;
+        eventsWrapped = true;
+    }
+}
+
+void Profiler::recordFrame(Clock::duration frameTime) {
+    float ms = std::chrono::duration<float, std::milli>(frameTime).count();
+
+    std::lock_guard<std::mutex> lock(frameMutex);
+    if (frameTimes.size() < FrameHistory) {
+        frameTimes.push_back(ms);
+    } else {
+        frameTimes[nextFrame] = ms;
+    }
+    nextFrame = (nextFrame + 1) % FrameHistory;
+}
+
+bool Profiler::getFrameTimePercentiles(float& p50, float& p95, float& p99) const {
+    std::vector<float> sorted;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        sorted = frameTimes;
+    }
+    if (sorted.empty()) return false;
+
+    std::sort(sorted.begin(), sorted.end());
+    auto at = [&](float percentile) {
+        std::size_t index = static_cast<std::size_t>(percentile * (sorted.size() - 1) + 0.5f);
+        return sorted[index];
+    };
+    p50 = at(0.50f);
+    p95 = at(0.95f);
+    p99 = at(0.99f);
+    return true;
+}
+
+bool Profiler::writeChromeTrace(const std::string& filename, float seconds) const {
+    std::vector<Event> recent;
+    const std::int64_t since = toMicroseconds(Clock::now()) - static_cast<std::int64_t>(seconds * 1e6f);
+    {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        std::size_t count = eventsWrapped ? events.size() : nextEvent;
+        std::size_t first = eventsWrapped ? nextEvent : 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Event& event = events[(first + i) % events.size()];
+            if (event.startUs >= since) {
+                recent.push_back(event);
+            }
+        }
+    }
+
+    std::ofstream out(filename, std::ios::trunc);
+    if (!out) return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Editor\"}}";
+    for (const Event& event : recent) {
+        // Os nomes são literais do próprio código, sem aspas nem barras a escapar
+        out << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+            << ",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs << "}";
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Instrumentação leve por escopo (PROFILE_SCOPE) e estatísticas de quadro.
+// Desligado, cada escopo custa uma leitura atômica; com EDITOR_NO_PROFILER
+// definido, as macros somem por completo. Ligado, os intervalos de todas as
+// threads vão para um buffer circular que pode ser exportado no formato
+// trace_event do Chrome (chrome://tracing, Perfetto).
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t EventCapacity = 1 << 18;  // Intervalos guardados (os mais antigos são sobrescritos)
+    static constexpr std::size_t FrameHistory = 240;       // Quadros usados nos percentis
+
+    static Profiler& instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Seguro em qualquer thread; name precisa ser um literal (só o ponteiro é guardado)
+    void record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+    void recordFrame(Clock::duration frameTime);
+    // Percentis (em ms) dos últimos FrameHistory quadros; false se ainda não há quadros
+    bool getFrameTimePercentiles(float& p50, float& p95, float& p99) const;
+
+    // Grava os intervalos dos últimos `seconds` segundos como trace_event JSON
+    bool writeChromeTrace(const std::string& filename, float seconds) const;
+
+private:
+    struct Event {
+        const char* name;
+        std::uint32_t threadId;
+        std::int64_t startUs;
+        std::int64_t durationUs;
+    };
+
+    Profiler();
+    static std::uint32_t currentThreadId();
+    std::int64_t toMicroseconds(Clock::time_point time) const;
+
+    std::atomic<bool> enabled{false};
+    Clock::time_point origin;
+
+    mutable std::mutex eventMutex;
+    std::vector<Event> events;  // Buffer circular de EventCapacity posições
+    std::size_t nextEvent = 0;
+    bool eventsWrapped = false;
+
+    mutable std::mutex frameMutex;
+    std::vector<float> frameTimes;  // Buffer circular de FrameHistory posições, em ms
+    std::size_t nextFrame = 0;
+};
+
+// Mede o tempo entre a construção e a destruição
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(Profiler::instance().isEnabled() ? name : nullptr) {
+        if (this->name) begin = Profiler::Clock::now();
+    }
+    ~ProfileScope() {
+        if (name) Profiler::instance().record(name, begin, Profiler::Clock::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    Profiler::Clock::time_point begin;
+};
+
+#ifdef EDITOR_NO_PROFILER
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
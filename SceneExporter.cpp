@@ -0,0 +1,217 @@
+#include "SceneExporter.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <future>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+// Profundidade dos elementos <Entity> dentro de <Ethanon><EntitiesInScene>
+const int EntityDepth = 2;
+
+}
+
+SceneExporter::SceneExporter(std::size_t threadCount) : threadCount(threadCount) {
+    if (this->threadCount == 0) {
+        this->threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool SceneExporter::exportEsc(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager) {
+    PROFILE_SCOPE("exportEsc");
+    // Passada serial: a cena pode precisar ler chunks descarregados do disco
+    instances.clear();
+    bool complete = scene.forEachInstance([&](const PlacedInstance& instance) {
+        const Entity* entity = entityManager.getEntityById(instance.prototypeId);
+        if (!entity) return;
+
+        // Apenas o nome do arquivo da entidade, sem copiar a string
+        std::string_view entityFileName = entity->getName();
+        size_t lastSlash = entityFileName.find_last_of("/\\");
+        if (lastSlash != std::string_view::npos) {
+            entityFileName.remove_prefix(lastSlash + 1);
+        }
+        instances.push_back({instance, entityFileName});
+    });
+    if (!complete) {
+        // Um chunk ilegível (já registrado pela cena) deixaria o .esc sem parte das instâncias
+        instances.clear();
+        return false;
+    }
+
+    // A cena guarda as instâncias por chunk; o .esc sai na ordem de inserção,
+    // que define os ids e o desempate da ordem de desenho no Ethanon
+    std::stable_sort(instances.begin(), instances.end(), [](const ExportedInstance& a, const ExportedInstance& b) {
+        return a.instance.sequence < b.instance.sequence;
+    });
+
+    // Serialização das faixas em paralelo
+    std::size_t rangeSize = std::max(MinRangeSize, (instances.size() + threadCount * 4 - 1) / (threadCount * 4));
+    std::vector<std::future<std::string>> ranges;
+    {
+        ThreadPool pool(std::min(threadCount, (instances.size() + rangeSize - 1) / rangeSize + 1));
+        for (std::size_t begin = 0; begin < instances.size(); begin += rangeSize) {
+            std::size_t end = std::min(instances.size(), begin + rangeSize);
+            ranges.push_back(pool.submit([this, begin, end]() { return serializeRange(begin, end); }));
+        }
+        for (auto& range : ranges) {
+            range.wait();
+        }
+    }
+
+    XmlStreamWriter writer;
+    writer.reset();
+    writer.pushDeclaration("xml version=\"1.0\" encoding=\"UTF-8\"");
+    writer.openElement("Ethanon");
+
+    // Scene Properties
+    writer.openElement("SceneProperties");
+    writer.pushAttribute("lightIntensity", "2");
+    writer.pushAttribute("parallaxIntensity", "0");
+
+    writer.openElement("Ambient");
+    writer.pushAttribute("r", "1");
+    writer.pushAttribute("g", "1");
+    writer.pushAttribute("b", "1");
+    writer.closeElement();
+
+    writer.openElement("ZAxisDirection");
+    writer.pushAttribute("x", "0");
+    writer.pushAttribute("y", "-1");
+    writer.closeElement();
+
+    writer.closeElement();  // SceneProperties
+
+    // Entities in Scene
+    writer.openElement("EntitiesInScene");
+    if (!instances.empty()) {
+        writer.pushExternalChildren();
+    }
+    std::string header = writer.takeBuffer();
+
+    writer.closeElement();  // EntitiesInScene
+    writer.closeElement();  // Ethanon
+
+    std::vector<std::string> bodies;
+    bodies.reserve(ranges.size());
+    for (auto& range : ranges) {
+        bodies.push_back(range.get());
+    }
+
+    std::vector<std::string_view> pieces;
+    pieces.reserve(bodies.size() + 2);
+    pieces.push_back(header);
+    for (const auto& body : bodies) {
+        pieces.push_back(body);
+    }
+    pieces.push_back(writer.getBuffer());
+
+    return writeFile(filename, pieces);
+}
+
+std::string SceneExporter::serializeRange(std::size_t begin, std::size_t end) const {
+    PROFILE_SCOPE("serializeRange");
+    XmlStreamWriter writer;
+    writer.reset(EntityDepth);
+    for (std::size_t i = begin; i < end; ++i) {
+        writeEntity(writer, static_cast<int>(i + 1), instances[i].instance, instances[i].entityFileName);
+    }
+    return writer.takeBuffer();
+}
+
+void SceneExporter::writeEntity(XmlStreamWriter& writer, int id, const PlacedInstance& instance,
+                                std::string_view entityFileName) {
+    writer.openElement("Entity");
+    writer.pushAttribute("id", id);
+    writer.pushAttribute("spriteFrame", instance.spriteFrame);
+
+    writer.openElement("EntityName");
+    writer.pushText(entityFileName);
+    writer.closeElement();
+
+    writer.openElement("Position");
+    writer.pushAttribute("x", static_cast<int>(instance.x));
+    writer.pushAttribute("y", static_cast<int>(instance.y));
+    writer.pushAttribute("z", 0);
+    writer.pushAttribute("angle", 0);
+    writer.closeElement();
+
+    writer.openElement("Entity");
+    writer.openElement("FileName");
+    writer.pushText(entityFileName);
+    writer.closeElement();
+
+    writer.openElement("CustomData");
+    writeCustomDataVariable(writer, "uint", "allowDecals", "1");
+    writeCustomDataVariable(writer, "string", "material", "stone");
+    writer.closeElement();  // CustomData
+
+    writer.closeElement();  // Entity (detalhes)
+    writer.closeElement();  // Entity
+}
+
+void SceneExporter::writeCustomDataVariable(XmlStreamWriter& writer, const char* type, const char* name, const char* value) {
+    writer.openElement("Variable");
+
+    writer.openElement("Type");
+    writer.pushText(type);
+    writer.closeElement();
+
+    writer.openElement("Name");
+    writer.pushText(name);
+    writer.closeElement();
+
+    writer.openElement("Value");
+    writer.pushText(value);
+    writer.closeElement();
+
+    writer.closeElement();
+}
+
+bool SceneExporter::writeFile(const std::string& filename, const std::vector<std::string_view>& pieces) {
+    int fileDescriptor = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    std::vector<iovec> vectors;
+    vectors.reserve(pieces.size());
+    for (const auto& piece : pieces) {
+        if (!piece.empty()) {
+            vectors.push_back({const_cast<char*>(piece.data()), piece.size()});
+        }
+    }
+
+    // writev pode escrever menos do que o pedido e aceita no máximo IOV_MAX vetores
+    bool ok = true;
+    std::size_t next = 0;
+    while (next < vectors.size()) {
+        int count = static_cast<int>(std::min<std::size_t>(vectors.size() - next, IOV_MAX));
+        ssize_t written = ::writev(fileDescriptor, vectors.data() + next, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+
+        std::size_t remaining = static_cast<std::size_t>(written);
+        while (next < vectors.size() && remaining >= vectors[next].iov_len) {
+            remaining -= vectors[next].iov_len;
+            ++next;
+        }
+        if (remaining > 0) {
+            vectors[next].iov_base = static_cast<char*>(vectors[next].iov_base) + remaining;
+            vectors[next].iov_len -= remaining;
+        }
+    }
+
+    if (::close(fileDescriptor) != 0) {
+        ok = false;
+    }
+    return ok;
+}
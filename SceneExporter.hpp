@@ -0,0 +1,37 @@
+#pragma once
+#include "ChunkedScene.hpp"
+#include "EntityManager.hpp"
+#include "XmlStreamWriter.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Exporta a cena no formato .esc do Ethanon sem montar um XMLDocument.
+// As entidades saem na ordem em que foram colocadas (PlacedInstance::sequence).
+// As instâncias são divididas em faixas serializadas em paralelo, cada uma no
+// seu próprio buffer; os ids sequenciais vêm da posição na lista, então o
+// resultado é idêntico ao da exportação serial. Os buffers são gravados com
+// um único writev.
+class SceneExporter {
+public:
+    static constexpr std::size_t MinRangeSize = 2048;  // Instâncias por tarefa, no mínimo
+
+    explicit SceneExporter(std::size_t threadCount = 0);
+
+    bool exportEsc(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager);
+
+private:
+    struct ExportedInstance {
+        PlacedInstance instance;
+        std::string_view entityFileName;  // Aponta para o nome do protótipo
+    };
+
+    std::string serializeRange(std::size_t begin, std::size_t end) const;
+    static void writeEntity(XmlStreamWriter& writer, int id, const PlacedInstance& instance,
+                            std::string_view entityFileName);
+    static void writeCustomDataVariable(XmlStreamWriter& writer, const char* type, const char* name, const char* value);
+    static bool writeFile(const std::string& filename, const std::vector<std::string_view>& pieces);
+
+    std::size_t threadCount;
+    std::vector<ExportedInstance> instances;  // Reaproveitado entre exportações
+};
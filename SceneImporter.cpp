@@ -0,0 +1,135 @@
+#include "SceneImporter.hpp"
+#include "Log.hpp"
+#include "MappedFile.hpp"
+#include "Profiler.hpp"
+#include "XmlStreamReader.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Instância lida do arquivo, aplicada à cena só depois da leitura completa
+struct ParsedInstance {
+    PrototypeId prototypeId;
+    sf::Vector2f position;
+    sf::Vector2f size;
+    int spriteFrame;
+};
+
+}
+
+bool SceneImporter::importEsc(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager) {
+    PROFILE_SCOPE("importEsc");
+    importedCount = 0;
+    skippedCount = 0;
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        LOG_ERROR("Não foi possível abrir a cena: " << filename);
+        return false;
+    }
+
+    XmlStreamReader reader(file.data(), file.size());
+    std::unordered_map<std::string, PrototypeId> prototypeByName;
+
+    // Profundidades: Ethanon = 1, EntitiesInScene = 2, Entity = 3, filhos = 4
+    int depth = 0;
+    int entitiesDepth = -1;
+    bool foundEntities = false;
+    bool closedEntities = false;
+    bool inEntity = false;
+    bool inEntityName = false;
+
+    std::string entityName;
+    sf::Vector2f position;
+    int spriteFrame = 0;
+
+    // A cena atual só é substituída se o arquivo inteiro for lido sem erro
+    std::vector<ParsedInstance> parsed;
+    for (;;) {
+        XmlStreamReader::Event event = reader.next();
+        if (event == XmlStreamReader::Event::EndOfDocument) {
+            // Um arquivo cortado entre tags (cópia parcial, gravação interrompida)
+            // termina com elementos abertos: é recusado como o tinyxml2 fazia
+            if (depth != 0) {
+                LOG_ERROR("Arquivo truncado, " << depth << " elemento(s) sem fechamento: " << filename);
+                return false;
+            }
+            break;
+        }
+        if (event == XmlStreamReader::Event::Error) {
+            LOG_ERROR("Erro ao ler " << filename << " (byte " << reader.getOffset() << "): "
+                      << reader.getError());
+            return false;
+        }
+
+        if (event == XmlStreamReader::Event::StartElement) {
+            ++depth;
+            std::string_view name = reader.getName();
+            if (entitiesDepth < 0) {
+                if (name == "EntitiesInScene") {
+                    entitiesDepth = depth;
+                    foundEntities = true;
+                }
+            } else if (depth == entitiesDepth + 1 && name == "Entity") {
+                inEntity = true;
+                entityName.clear();
+                position = sf::Vector2f();
+                spriteFrame = 0;
+                reader.getAttribute("spriteFrame", spriteFrame);
+            } else if (inEntity && depth == entitiesDepth + 2) {
+                if (name == "EntityName") {
+                    inEntityName = true;
+                } else if (name == "Position") {
+                    reader.getAttribute("x", position.x);
+                    reader.getAttribute("y", position.y);
+                }
+            }
+        } else if (event == XmlStreamReader::Event::Text) {
+            if (inEntityName) {
+                entityName = reader.getText();
+            }
+        } else if (event == XmlStreamReader::Event::EndElement) {
+            if (inEntityName && depth == entitiesDepth + 2) {
+                inEntityName = false;
+            } else if (inEntity && depth == entitiesDepth + 1) {
+                inEntity = false;
+
+                auto it = prototypeByName.find(entityName);
+                if (it == prototypeByName.end()) {
+                    it = prototypeByName.emplace(entityName, entityManager.getEntityIdByPath(entityName)).first;
+                    if (it->second == InvalidPrototypeId) {
+                        LOG_WARNING("Entidade não encontrada na cena importada: " << entityName);
+                    }
+                }
+
+                const Entity* entity = entityManager.getEntityById(it->second);
+                if (entity) {
+                    parsed.push_back({it->second, position, entity->getFrameSize(spriteFrame), spriteFrame});
+                    ++importedCount;
+                } else {
+                    ++skippedCount;
+                }
+            } else if (depth == entitiesDepth) {
+                entitiesDepth = -1;
+                closedEntities = true;
+            }
+            --depth;
+        }
+    }
+
+    if (!foundEntities) {
+        LOG_ERROR("Nenhum elemento EntitiesInScene em " << filename);
+        return false;
+    }
+    if (!closedEntities) {
+        LOG_ERROR("EntitiesInScene sem fechamento em " << filename);
+        return false;
+    }
+
+    scene.clear();
+    for (const ParsedInstance& instance : parsed) {
+        scene.add(instance.prototypeId, instance.position, instance.size, instance.spriteFrame);
+    }
+    return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "ChunkedScene.hpp"
+#include "EntityManager.hpp"
+#include <string>
+
+// Importa cenas .esc do Ethanon (EntitiesInScene) para a ChunkedScene.
+// O arquivo é mapeado em memória e percorrido uma única vez com o
+// XmlStreamReader, sem montar um XMLDocument. Os nomes das entidades são
+// resolvidos no EntityManager uma vez por nome; nenhuma textura é carregada.
+// Se o arquivo tiver erro ou não tiver EntitiesInScene, a cena não é alterada.
+class SceneImporter {
+public:
+    bool importEsc(const std::string& filename, ChunkedScene& scene, const EntityManager& entityManager);
+
+    std::size_t getImportedCount() const { return importedCount; }
+    std::size_t getSkippedCount() const { return skippedCount; }
+
+private:
+    std::size_t importedCount = 0;
+    std::size_t skippedCount = 0;
+};
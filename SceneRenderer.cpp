@@ -0,0 +1,175 @@
+#include "SceneRenderer.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+SceneRenderer::SceneRenderer() {
+    overlayBatch.texture = nullptr;
+    overlayIconBatch.texture = nullptr;
+}
+
+void SceneRenderer::setOverlayTexture(const sf::Texture* texture) {
+    if (overlayTexture != texture) {
+        overlayTexture = texture;
+        dirty = true;
+    }
+}
+
+void SceneRenderer::clear() {
+    spriteBatches.clear();
+    overlayBatch = Batch();
+    overlayIconBatch = Batch();
+    visibleIds.clear();
+    visibleIds.shrink_to_fit();
+    dirty = true;
+}
+
+void SceneRenderer::appendQuad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect,
+                               const sf::FloatRect& texRect, const sf::Color& color) {
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+
+    sf::Vector2f texTopLeft(texRect.left, texRect.top);
+    sf::Vector2f texTopRight(texRect.left + texRect.width, texRect.top);
+    sf::Vector2f texBottomRight(texRect.left + texRect.width, texRect.top + texRect.height);
+    sf::Vector2f texBottomLeft(texRect.left, texRect.top + texRect.height);
+
+    vertices.emplace_back(topLeft, color, texTopLeft);
+    vertices.emplace_back(topRight, color, texTopRight);
+    vertices.emplace_back(bottomRight, color, texBottomRight);
+
+    vertices.emplace_back(topLeft, color, texTopLeft);
+    vertices.emplace_back(bottomRight, color, texBottomRight);
+    vertices.emplace_back(bottomLeft, color, texBottomLeft);
+}
+
+void SceneRenderer::rebuild(const InstanceStore& instances, const EntityManager& entityManager,
+                            const sf::FloatRect& visibleArea) {
+    for (auto& batch : spriteBatches) {
+        batch.vertices.clear();
+    }
+    overlayBatch.vertices.clear();
+    overlayIconBatch.vertices.clear();
+    overlayIconBatch.texture = overlayTexture;
+
+    std::unordered_map<const sf::Texture*, std::size_t> batchByTexture;
+    for (std::size_t i = 0; i < spriteBatches.size(); ++i) {
+        batchByTexture[spriteBatches[i].texture] = i;
+    }
+
+    const sf::FloatRect noTexture;
+    const sf::Color fillColor(200, 0, 0, 128);  // Vermelho semi-transparente
+    const sf::Color outlineColor = sf::Color::Red;
+
+    // Mantém a ordem de inserção dentro de cada lote
+    instances.queryRect(visibleArea, visibleIds);
+    std::sort(visibleIds.begin(), visibleIds.end());
+
+    for (std::uint32_t id : visibleIds) {
+        const PlacedInstance& instance = instances[id];
+        const Entity* entity = entityManager.getEntityById(instance.prototypeId);
+        if (!entity) continue;
+
+        if (entity->hasSprite()) {
+            const sf::Texture* texture = entity->getTexture();
+            const auto& spriteDefinitions = entity->getSpriteDefinitions();
+            if (!texture || instance.spriteFrame < 0 || instance.spriteFrame >= static_cast<int>(spriteDefinitions.size())) {
+                continue;
+            }
+
+            auto it = batchByTexture.find(texture);
+            if (it == batchByTexture.end()) {
+                it = batchByTexture.emplace(texture, spriteBatches.size()).first;
+                spriteBatches.emplace_back();
+                spriteBatches.back().texture = texture;
+                spriteBatches.back().source = entity;
+            }
+
+            const sf::IntRect& frame = spriteDefinitions[instance.spriteFrame].rect;
+            sf::FloatRect rect(instance.x, instance.y, frame.width, frame.height);
+            appendQuad(spriteBatches[it->second].vertices, rect, sf::FloatRect(frame), sf::Color::White);
+        } else {
+            sf::Vector2f size = entity->getCollisionSize();
+            sf::FloatRect rect(instance.x, instance.y, size.x, size.y);
+
+            // Preenchimento e contorno de 1px por fora, como o antigo sf::RectangleShape
+            appendQuad(overlayBatch.vertices, rect, noTexture, fillColor);
+            appendQuad(overlayBatch.vertices, sf::FloatRect(rect.left - 1, rect.top - 1, rect.width + 2, 1), noTexture, outlineColor);
+            appendQuad(overlayBatch.vertices, sf::FloatRect(rect.left - 1, rect.top + rect.height, rect.width + 2, 1), noTexture, outlineColor);
+            appendQuad(overlayBatch.vertices, sf::FloatRect(rect.left - 1, rect.top, 1, rect.height), noTexture, outlineColor);
+            appendQuad(overlayBatch.vertices, sf::FloatRect(rect.left + rect.width, rect.top, 1, rect.height), noTexture, outlineColor);
+
+            if (overlayTexture) {
+                sf::Vector2u iconSize = overlayTexture->getSize();
+                appendQuad(overlayIconBatch.vertices, rect, sf::FloatRect(0, 0, iconSize.x, iconSize.y), sf::Color::White);
+            }
+        }
+    }
+
+    // Descarta lotes de texturas que não aparecem mais na cena
+    for (auto it = spriteBatches.begin(); it != spriteBatches.end();) {
+        if (it->vertices.empty()) {
+            it = spriteBatches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto& batch : spriteBatches) {
+        upload(batch);
+    }
+    upload(overlayBatch);
+    upload(overlayIconBatch);
+
+    builtArea = visibleArea;
+    builtRevision = instances.getRevision();
+    dirty = false;
+}
+
+bool SceneRenderer::texturesChanged() const {
+    // Pedir a textura a cada quadro também a marca como em uso no TextureCache
+    bool changed = false;
+    for (const auto& batch : spriteBatches) {
+        if (batch.source && batch.source->getTexture() != batch.texture) {
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void SceneRenderer::upload(Batch& batch) {
+    if (!sf::VertexBuffer::isAvailable() || batch.vertices.empty()) return;
+
+    if (batch.buffer.getVertexCount() != batch.vertices.size()) {
+        batch.buffer.create(batch.vertices.size());
+    }
+    batch.buffer.update(batch.vertices.data());
+}
+
+void SceneRenderer::drawBatch(sf::RenderTarget& target, const Batch& batch, sf::RenderStates states) {
+    if (batch.vertices.empty()) return;
+
+    states.texture = batch.texture;
+    if (sf::VertexBuffer::isAvailable()) {
+        target.draw(batch.buffer, states);
+    } else {
+        target.draw(batch.vertices.data(), batch.vertices.size(), sf::Triangles, states);
+    }
+    ++drawCallCount;
+}
+
+void SceneRenderer::render(sf::RenderTarget& target, const InstanceStore& instances,
+                           const EntityManager& entityManager, const sf::RenderStates& states,
+                           const sf::FloatRect& visibleArea) {
+    if (texturesChanged() || dirty || builtRevision != instances.getRevision() || builtArea != visibleArea) {
+        rebuild(instances, entityManager, visibleArea);
+    }
+
+    drawCallCount = 0;
+    for (const auto& batch : spriteBatches) {
+        drawBatch(target, batch, states);
+    }
+    drawBatch(target, overlayBatch, states);
+    drawBatch(target, overlayIconBatch, states);
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "EntityManager.hpp"
+#include "InstanceStore.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Renderizador em lote das instâncias colocadas.
+// Agrupa os quads por textura (um lote por atlas) e mantém um lote extra para a
+// sobreposição das entidades invisíveis. Só entram nos lotes as instâncias que
+// o índice espacial reporta dentro da área visível. Os lotes só são
+// reconstruídos quando a revisão do InstanceStore ou a área visível mudam, ou
+// quando o TextureCache descartou e recarregou a textura de algum lote.
+class SceneRenderer {
+public:
+    SceneRenderer();
+
+    void setOverlayTexture(const sf::Texture* texture);
+    void invalidate() { dirty = true; }
+    void clear();  // Libera os lotes (vértices e buffers)
+
+    void render(sf::RenderTarget& target, const InstanceStore& instances,
+                const EntityManager& entityManager, const sf::RenderStates& states,
+                const sf::FloatRect& visibleArea);
+
+    std::size_t getDrawCallCount() const { return drawCallCount; }
+
+private:
+    struct Batch {
+        const sf::Texture* texture = nullptr;
+        const Entity* source = nullptr;  // Protótipo que forneceu a textura (revalidada a cada quadro)
+        std::vector<sf::Vertex> vertices;
+        sf::VertexBuffer buffer;
+
+        Batch() : buffer(sf::Triangles, sf::VertexBuffer::Static) {}
+    };
+
+    void rebuild(const InstanceStore& instances, const EntityManager& entityManager,
+                 const sf::FloatRect& visibleArea);
+    bool texturesChanged() const;
+    void upload(Batch& batch);
+    void drawBatch(sf::RenderTarget& target, const Batch& batch, sf::RenderStates states);
+    static void appendQuad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect,
+                           const sf::FloatRect& texRect, const sf::Color& color);
+
+    std::vector<Batch> spriteBatches;
+    Batch overlayBatch;      // Preenchimento e contorno das entidades invisíveis
+    Batch overlayIconBatch;  // Ícone invisible.png escalado para a colisão
+    const sf::Texture* overlayTexture = nullptr;
+
+    std::vector<std::uint32_t> visibleIds;
+    sf::FloatRect builtArea;
+    std::uint64_t builtRevision = 0;
+    bool dirty = true;
+    std::size_t drawCallCount = 0;
+};
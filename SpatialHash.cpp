@@ -0,0 +1,264 @@
+#include "SpatialHash.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize) : cellSize(cellSize > 0 ? cellSize : 32.0f) {
+}
+
+SpatialHash::CellKey SpatialHash::makeKey(int cellX, int cellY) {
+    return (static_cast<CellKey>(static_cast<std::uint32_t>(cellX)) << 32) | static_cast<std::uint32_t>(cellY);
+}
+
+int SpatialHash::cellCoord(float value) const {
+    return static_cast<int>(std::floor(value / cellSize));
+}
+
+SpatialHash::CellRange SpatialHash::cellRange(const sf::FloatRect& rect) const {
+    CellRange range;
+    range.minX = cellCoord(rect.left);
+    range.minY = cellCoord(rect.top);
+    // A borda direita/inferior é exclusiva, como em sf::Rect::contains
+    range.maxX = std::max(range.minX, static_cast<int>(std::ceil((rect.left + rect.width) / cellSize)) - 1);
+    range.maxY = std::max(range.minY, static_cast<int>(std::ceil((rect.top + rect.height) / cellSize)) - 1);
+    return range;
+}
+
+void SpatialHash::setCellSize(float size) {
+    if (size <= 0 || size == cellSize) return;
+
+    cellSize = size;
+    cells.clear();
+    hasOccupied = false;
+    for (std::uint32_t id = 0; id < bounds.size(); ++id) {
+        if (present[id]) {
+            addToCells(id, bounds[id]);
+        }
+    }
+}
+
+void SpatialHash::addToCells(std::uint32_t id, const sf::FloatRect& rect) {
+    CellRange range = cellRange(rect);
+    for (int y = range.minY; y <= range.maxY; ++y) {
+        for (int x = range.minX; x <= range.maxX; ++x) {
+            cells[makeKey(x, y)].push_back(id);
+        }
+    }
+
+    if (!hasOccupied) {
+        occupied = range;
+        hasOccupied = true;
+    } else {
+        occupied.minX = std::min(occupied.minX, range.minX);
+        occupied.minY = std::min(occupied.minY, range.minY);
+        occupied.maxX = std::max(occupied.maxX, range.maxX);
+        occupied.maxY = std::max(occupied.maxY, range.maxY);
+    }
+}
+
+void SpatialHash::removeFromCells(std::uint32_t id, const sf::FloatRect& rect) {
+    CellRange range = cellRange(rect);
+    for (int y = range.minY; y <= range.maxY; ++y) {
+        for (int x = range.minX; x <= range.maxX; ++x) {
+            auto it = cells.find(makeKey(x, y));
+            if (it == cells.end()) continue;
+
+            auto& ids = it->second;
+            auto found = std::find(ids.begin(), ids.end(), id);
+            if (found != ids.end()) {
+                *found = ids.back();
+                ids.pop_back();
+            }
+            if (ids.empty()) {
+                cells.erase(it);
+            }
+        }
+    }
+}
+
+void SpatialHash::insert(std::uint32_t id, const sf::FloatRect& rect) {
+    if (contains(id)) {
+        update(id, rect);
+        return;
+    }
+
+    if (id >= bounds.size()) {
+        bounds.resize(id + 1);
+        present.resize(id + 1, false);
+    }
+    bounds[id] = rect;
+    present[id] = true;
+    addToCells(id, rect);
+}
+
+void SpatialHash::update(std::uint32_t id, const sf::FloatRect& rect) {
+    if (!contains(id)) {
+        insert(id, rect);
+        return;
+    }
+
+    removeFromCells(id, bounds[id]);
+    bounds[id] = rect;
+    addToCells(id, rect);
+}
+
+void SpatialHash::remove(std::uint32_t id) {
+    if (!contains(id)) return;
+
+    removeFromCells(id, bounds[id]);
+    present[id] = false;
+
+    while (!present.empty() && !present.back()) {
+        present.pop_back();
+        bounds.pop_back();
+    }
+}
+
+void SpatialHash::relabel(std::uint32_t from, std::uint32_t to) {
+    if (!contains(from) || from == to) return;
+
+    sf::FloatRect rect = bounds[from];
+    remove(from);
+    insert(to, rect);
+}
+
+void SpatialHash::clear() {
+    cells.clear();
+    bounds.clear();
+    present.clear();
+    visitStamp.clear();
+    hasOccupied = false;
+}
+
+void SpatialHash::collectCell(int cellX, int cellY, std::vector<std::uint32_t>& out) const {
+    auto it = cells.find(makeKey(cellX, cellY));
+    if (it == cells.end()) return;
+
+    for (std::uint32_t id : it->second) {
+        if (visitStamp[id] != currentStamp) {
+            visitStamp[id] = currentStamp;
+            out.push_back(id);
+        }
+    }
+}
+
+void SpatialHash::queryPoint(sf::Vector2f point, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    auto it = cells.find(makeKey(cellCoord(point.x), cellCoord(point.y)));
+    if (it == cells.end()) return;
+
+    for (std::uint32_t id : it->second) {
+        if (bounds[id].contains(point)) {
+            out.push_back(id);
+        }
+    }
+}
+
+void SpatialHash::queryRect(const sf::FloatRect& rect, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (cells.empty()) return;
+
+    if (visitStamp.size() < bounds.size()) {
+        visitStamp.resize(bounds.size(), 0);
+    }
+    if (++currentStamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        currentStamp = 1;
+    }
+
+    CellRange range = cellRange(rect);
+    if (hasOccupied) {
+        range.minX = std::max(range.minX, occupied.minX);
+        range.minY = std::max(range.minY, occupied.minY);
+        range.maxX = std::min(range.maxX, occupied.maxX);
+        range.maxY = std::min(range.maxY, occupied.maxY);
+    }
+
+    std::vector<std::uint32_t> candidates;
+    for (int y = range.minY; y <= range.maxY; ++y) {
+        for (int x = range.minX; x <= range.maxX; ++x) {
+            collectCell(x, y, candidates);
+        }
+    }
+
+    for (std::uint32_t id : candidates) {
+        if (bounds[id].intersects(rect)) {
+            out.push_back(id);
+        }
+    }
+}
+
+float SpatialHash::distanceToRect(sf::Vector2f point, const sf::FloatRect& rect) {
+    float dx = std::max({rect.left - point.x, 0.0f, point.x - (rect.left + rect.width)});
+    float dy = std::max({rect.top - point.y, 0.0f, point.y - (rect.top + rect.height)});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+void SpatialHash::queryNearest(sf::Vector2f point, std::size_t count, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    if (count == 0 || cells.empty() || !hasOccupied) return;
+
+    if (visitStamp.size() < bounds.size()) {
+        visitStamp.resize(bounds.size(), 0);
+    }
+    if (++currentStamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0);
+        currentStamp = 1;
+    }
+
+    const int centerX = cellCoord(point.x);
+    const int centerY = cellCoord(point.y);
+    // Anéis antes da área ocupada estão vazios; depois dela não há o que achar
+    const int firstRing = std::max({0, occupied.minX - centerX, centerX - occupied.maxX,
+                                    occupied.minY - centerY, centerY - occupied.maxY});
+    const int maxRing = std::max({std::abs(centerX - occupied.minX), std::abs(centerX - occupied.maxX),
+                                  std::abs(centerY - occupied.minY), std::abs(centerY - occupied.maxY)});
+
+    std::vector<std::pair<float, std::uint32_t>> found;
+    std::vector<std::uint32_t> ringIds;
+
+    // Percorre anéis de células ao redor do ponto até que nenhum anel mais
+    // distante possa conter algo mais próximo que os k já encontrados.
+    // Cada anel é recortado à área ocupada, então um ponto longe da cena não
+    // custa mais que o perímetro dela por anel
+    for (int ring = firstRing; ring <= maxRing; ++ring) {
+        ringIds.clear();
+        const int minX = std::max(centerX - ring, occupied.minX);
+        const int maxX = std::min(centerX + ring, occupied.maxX);
+        const int minY = std::max(centerY - ring, occupied.minY);
+        const int maxY = std::min(centerY + ring, occupied.maxY);
+        for (int y = minY; y <= maxY; ++y) {
+            if (y == centerY - ring || y == centerY + ring) {
+                for (int x = minX; x <= maxX; ++x) {
+                    collectCell(x, y, ringIds);
+                }
+            } else {
+                if (centerX - ring >= occupied.minX) {
+                    collectCell(centerX - ring, y, ringIds);
+                }
+                if (centerX + ring <= occupied.maxX) {
+                    collectCell(centerX + ring, y, ringIds);
+                }
+            }
+        }
+
+        for (std::uint32_t id : ringIds) {
+            found.emplace_back(distanceToRect(point, bounds[id]), id);
+        }
+
+        if (found.size() >= count) {
+            std::nth_element(found.begin(), found.begin() + (count - 1), found.end());
+            float ringDistance = ring * cellSize;
+            if (found[count - 1].first <= ringDistance) {
+                break;
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    if (found.size() > count) {
+        found.resize(count);
+    }
+    for (const auto& entry : found) {
+        out.push_back(entry.second);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Índice espacial em grade uniforme (hash de células) sobre retângulos.
+// Cada id é registrado em todas as células que seu retângulo cobre, o que
+// permite consultas por ponto, por retângulo e dos k vizinhos mais próximos
+// sem varrer todas as instâncias.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 32.0f);
+
+    void setCellSize(float size);
+    float getCellSize() const { return cellSize; }
+
+    void insert(std::uint32_t id, const sf::FloatRect& bounds);
+    void update(std::uint32_t id, const sf::FloatRect& bounds);
+    void remove(std::uint32_t id);
+    // Renomeia 'from' para 'to' (usado quando o armazenamento compacta os ids)
+    void relabel(std::uint32_t from, std::uint32_t to);
+    void clear();
+
+    bool contains(std::uint32_t id) const { return id < present.size() && present[id]; }
+    const sf::FloatRect& getBounds(std::uint32_t id) const { return bounds[id]; }
+
+    void queryPoint(sf::Vector2f point, std::vector<std::uint32_t>& out) const;
+    void queryRect(const sf::FloatRect& rect, std::vector<std::uint32_t>& out) const;
+    void queryNearest(sf::Vector2f point, std::size_t count, std::vector<std::uint32_t>& out) const;
+
+private:
+    using CellKey = std::uint64_t;
+
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+    };
+
+    static CellKey makeKey(int cellX, int cellY);
+    int cellCoord(float value) const;
+    CellRange cellRange(const sf::FloatRect& rect) const;
+    void addToCells(std::uint32_t id, const sf::FloatRect& rect);
+    void removeFromCells(std::uint32_t id, const sf::FloatRect& rect);
+    void collectCell(int cellX, int cellY, std::vector<std::uint32_t>& out) const;
+    static float distanceToRect(sf::Vector2f point, const sf::FloatRect& rect);
+
+    float cellSize;
+    std::unordered_map<CellKey, std::vector<std::uint32_t>> cells;
+    std::vector<sf::FloatRect> bounds;
+    std::vector<bool> present;
+
+    // Limites das células já ocupadas (encerram a busca de vizinhos)
+    CellRange occupied;
+    bool hasOccupied = false;
+
+    // Marcação por consulta para não repetir ids que cobrem várias células
+    mutable std::vector<std::uint32_t> visitStamp;
+    mutable std::uint32_t currentStamp = 0;
+};
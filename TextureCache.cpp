@@ -0,0 +1,157 @@
+#include "TextureCache.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+TextureCache::TextureCache(std::size_t budgetBytes) : budgetBytes(budgetBytes) {
+}
+
+std::string TextureCache::normalizePath(const std::string& path) {
+    return fs::path(path).lexically_normal().generic_string();
+}
+
+TextureCache::Entry* TextureCache::find(const std::string& key) {
+    auto it = textures.find(key);
+    if (it == textures.end()) {
+        return nullptr;
+    }
+
+    Entry& entry = it->second;
+    entry.lastUsedFrame = currentFrame;
+    lru.splice(lru.begin(), lru, entry.lruPosition);
+    return &entry;
+}
+
+TextureCache::Entry& TextureCache::insert(const std::string& key, std::shared_ptr<const sf::Texture> texture) {
+    sf::Vector2u textureSize = texture->getSize();
+
+    Entry& entry = textures[key];
+    entry.texture = std::move(texture);
+    entry.bytes = static_cast<std::size_t>(textureSize.x) * textureSize.y * 4;
+    entry.lastUsedFrame = currentFrame;
+    lru.push_front(key);
+    entry.lruPosition = lru.begin();
+    residentBytes += entry.bytes;
+
+    evict(budgetBytes);
+    return entry;
+}
+
+void TextureCache::evict(std::size_t targetBytes) {
+    // Percorre da menos usada para a mais usada
+    auto it = lru.end();
+    while (residentBytes > targetBytes && it != lru.begin()) {
+        --it;
+        auto entryIt = textures.find(*it);
+        const Entry& entry = entryIt->second;
+        if (entry.lastUsedFrame == currentFrame || entry.texture.use_count() > 1) {
+            continue;
+        }
+
+        residentBytes -= entry.bytes;
+        ++evictionCount;
+        textures.erase(entryIt);
+        it = lru.erase(it);
+    }
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::acquire(const std::string& path) {
+    std::string key = normalizePath(path);
+    if (Entry* entry = find(key)) {
+        return entry->texture;
+    }
+
+    PROFILE_SCOPE("loadTexture");
+    ++loadCount;
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromFile(key)) {
+        LOG_ERROR("Failed to load texture: " << key);
+        return nullptr;
+    }
+    return insert(key, std::move(texture)).texture;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::acquire(const std::string& path, const sf::Image& image) {
+    std::string key = normalizePath(path);
+    if (Entry* entry = find(key)) {
+        return entry->texture;
+    }
+
+    PROFILE_SCOPE("uploadTexture");
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(image)) {
+        LOG_ERROR("Failed to upload texture: " << key);
+        return nullptr;
+    }
+    return insert(key, std::move(texture)).texture;
+}
+
+const sf::Texture* TextureCache::request(const std::string& path) {
+    return requestNormalized(normalizePath(path));
+}
+
+const sf::Texture* TextureCache::requestNormalized(const std::string& key) {
+    if (Entry* entry = find(key)) {
+        return entry->texture.get();
+    }
+    if (failedPaths.count(key)) {
+        return nullptr;
+    }
+
+    PROFILE_SCOPE("loadTexture");
+    ++loadCount;
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromFile(key)) {
+        LOG_ERROR("Failed to load texture: " << key);
+        failedPaths.insert(key);
+        return nullptr;
+    }
+    return insert(key, std::move(texture)).texture.get();
+}
+
+bool TextureCache::contains(const std::string& path) const {
+    return textures.count(normalizePath(path)) > 0;
+}
+
+void TextureCache::beginFrame() {
+    ++currentFrame;
+}
+
+void TextureCache::setBudget(std::size_t bytes) {
+    budgetBytes = bytes;
+    evict(budgetBytes);
+}
+
+void TextureCache::purge() {
+    evict(0);
+    failedPaths.clear();
+}
+
+bool TextureCache::readImageSize(const std::string& path, sf::Vector2u& size) {
+    // PNG: assinatura de 8 bytes seguida do chunk IHDR (largura e altura em big-endian)
+    static const unsigned char pngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    unsigned char header[24];
+    std::ifstream file(path, std::ios::binary);
+    if (file.read(reinterpret_cast<char*>(header), sizeof(header)) &&
+        std::equal(pngSignature, pngSignature + 8, header) &&
+        std::equal(header + 12, header + 16, reinterpret_cast<const unsigned char*>("IHDR"))) {
+        auto readBigEndian = [](const unsigned char* bytes) {
+            return (static_cast<unsigned int>(bytes[0]) << 24) | (static_cast<unsigned int>(bytes[1]) << 16) |
+                   (static_cast<unsigned int>(bytes[2]) << 8) | static_cast<unsigned int>(bytes[3]);
+        };
+        size = sf::Vector2u(readBigEndian(header + 16), readBigEndian(header + 20));
+        return size.x > 0 && size.y > 0;
+    }
+
+    // Outros formatos: decodifica a imagem só para descobrir o tamanho
+    sf::Image image;
+    if (!image.loadFromFile(path)) {
+        return false;
+    }
+    size = image.getSize();
+    return size.x > 0 && size.y > 0;
+}
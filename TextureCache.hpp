@@ -0,0 +1,67 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// Cache de texturas por caminho, com residência sob demanda.
+// As texturas só são carregadas no primeiro uso e ficam residentes enquanto
+// couberem no orçamento de memória; acima dele, as menos usadas recentemente
+// são descartadas e recarregadas de forma transparente no próximo request.
+// Texturas com donos externos (acquire) ou usadas no quadro atual nunca são descartadas.
+class TextureCache {
+public:
+    static constexpr std::size_t DefaultBudgetBytes = 256 * 1024 * 1024;
+
+    explicit TextureCache(std::size_t budgetBytes = DefaultBudgetBytes);
+
+    // Referência compartilhada: a textura fica fixa enquanto houver donos
+    std::shared_ptr<const sf::Texture> acquire(const std::string& path);
+    // Usa uma imagem já decodificada (p.ex. em outra thread) se o caminho não estiver em cache
+    std::shared_ptr<const sf::Texture> acquire(const std::string& path, const sf::Image& image);
+
+    // Acesso sob demanda. O ponteiro é válido até o fim do quadro atual (ver beginFrame)
+    const sf::Texture* request(const std::string& path);
+    // O mesmo, para caminhos que já passaram por normalizePath: só a busca no mapa
+    const sf::Texture* requestNormalized(const std::string& key);
+    // Chave usada pelo cache (caminho relativo normalizado, com '/')
+    static std::string normalizePath(const std::string& path);
+
+    bool contains(const std::string& path) const;  // Residente, sem contar como uso
+
+    void beginFrame();
+    void setBudget(std::size_t bytes);
+    std::size_t getBudget() const { return budgetBytes; }
+    std::size_t getResidentBytes() const { return residentBytes; }
+    std::size_t getEvictionCount() const { return evictionCount; }
+    std::size_t getLoadCount() const { return loadCount; }  // Leituras de arquivo (acquire/request sem cache)
+    std::size_t size() const { return textures.size(); }
+    void purge();  // Descarta tudo o que não está fixo nem em uso neste quadro
+
+    // Dimensões da imagem sem subir para a GPU (lê só o cabeçalho de PNGs)
+    static bool readImageSize(const std::string& path, sf::Vector2u& size);
+
+private:
+    struct Entry {
+        std::shared_ptr<const sf::Texture> texture;
+        std::size_t bytes = 0;
+        std::uint64_t lastUsedFrame = 0;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    Entry* find(const std::string& key);
+    Entry& insert(const std::string& key, std::shared_ptr<const sf::Texture> texture);
+    void evict(std::size_t targetBytes);
+
+    std::unordered_map<std::string, Entry> textures;
+    std::list<std::string> lru;  // Frente = usada mais recentemente
+    std::unordered_set<std::string> failedPaths;
+    std::size_t budgetBytes;
+    std::size_t residentBytes = 0;
+    std::size_t evictionCount = 0;
+    std::size_t loadCount = 0;
+    std::uint64_t currentFrame = 1;
+};
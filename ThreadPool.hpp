@@ -0,0 +1,49 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Pool fixo de threads de trabalho.
+// Tarefas ainda na fila quando o pool é destruído são descartadas; as que já
+// estão em execução terminam antes do destrutor retornar.
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename Task>
+    auto submit(Task&& task) -> std::future<decltype(task())>;
+
+    std::size_t getThreadCount() const { return workers.size(); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
+
+template <typename Task>
+auto ThreadPool::submit(Task&& task) -> std::future<decltype(task())> {
+    using Result = decltype(task());
+
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+    std::future<Result> result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.emplace([packaged]() { (*packaged)(); });
+    }
+    condition.notify_one();
+    return result;
+}
@@ -0,0 +1,216 @@
+#include "XmlStreamReader.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isNameChar(char c) {
+    return !isSpace(c) && c != '/' && c != '>' && c != '=' && c != '<';
+}
+
+void appendUtf8(std::string& out, unsigned long code) {
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+}
+
+XmlStreamReader::XmlStreamReader(const char* data, std::size_t size)
+    : begin(data), position(data), end(data + size) {
+}
+
+XmlStreamReader::Event XmlStreamReader::fail(const char* message) {
+    error = message;
+    position = end;
+    return Event::Error;
+}
+
+bool XmlStreamReader::skipPast(std::string_view terminator) {
+    std::string_view rest(position, end - position);
+    std::size_t found = rest.find(terminator);
+    if (found == std::string_view::npos) {
+        return false;
+    }
+    position += found + terminator.size();
+    return true;
+}
+
+XmlStreamReader::Event XmlStreamReader::next() {
+    if (pendingEnd) {
+        pendingEnd = false;
+        emptyElement = false;
+        return Event::EndElement;
+    }
+
+    while (position < end) {
+        if (*position != '<') {
+            // Texto até a próxima tag; só espaços entre elementos é ignorado
+            const char* start = position;
+            const char* tagStart = static_cast<const char*>(std::memchr(position, '<', end - position));
+            position = tagStart ? tagStart : end;
+
+            const char* first = start;
+            const char* last = position;
+            while (first < last && isSpace(*first)) ++first;
+            while (last > first && isSpace(*(last - 1))) --last;
+            if (first == last) continue;
+
+            decode(std::string_view(first, last - first), text);
+            return Event::Text;
+        }
+
+        std::string_view rest(position, end - position);
+        if (rest.compare(0, 4, "<!--") == 0) {
+            if (!skipPast("-->")) return fail("Comentário sem fim");
+            continue;
+        }
+        if (rest.compare(0, 9, "<![CDATA[") == 0) {
+            const char* start = position + 9;
+            position = start;
+            if (!skipPast("]]>")) return fail("CDATA sem fim");
+            text.assign(start, position - 3 - start);
+            return Event::Text;
+        }
+        if (rest.compare(0, 2, "<?") == 0 || rest.compare(0, 2, "<!") == 0) {
+            // Declaração, instrução de processamento ou DOCTYPE
+            if (!skipPast(">")) return fail("Declaração sem fim");
+            continue;
+        }
+
+        bool closing = rest.size() > 1 && rest[1] == '/';
+        const char* nameStart = position + (closing ? 2 : 1);
+        const char* nameEnd = nameStart;
+        while (nameEnd < end && isNameChar(*nameEnd)) ++nameEnd;
+        if (nameEnd == nameStart) return fail("Tag sem nome");
+        name = std::string_view(nameStart, nameEnd - nameStart);
+
+        // Fim da tag, respeitando '>' dentro de valores entre aspas
+        const char* cursor = nameEnd;
+        char quote = 0;
+        while (cursor < end && (quote || *cursor != '>')) {
+            if (quote) {
+                if (*cursor == quote) quote = 0;
+            } else if (*cursor == '"' || *cursor == '\'') {
+                quote = *cursor;
+            }
+            ++cursor;
+        }
+        if (cursor >= end) return fail("Tag sem fim");
+
+        position = cursor + 1;
+        if (closing) {
+            attributes = std::string_view();
+            emptyElement = false;
+            return Event::EndElement;
+        }
+
+        emptyElement = cursor > nameEnd && *(cursor - 1) == '/';
+        attributes = std::string_view(nameEnd, (emptyElement ? cursor - 1 : cursor) - nameEnd);
+        pendingEnd = emptyElement;
+        return Event::StartElement;
+    }
+
+    return Event::EndOfDocument;
+}
+
+bool XmlStreamReader::findAttribute(std::string_view attribute, std::string_view& raw) const {
+    std::size_t index = 0;
+    while (index < attributes.size()) {
+        while (index < attributes.size() && isSpace(attributes[index])) ++index;
+        std::size_t keyStart = index;
+        while (index < attributes.size() && attributes[index] != '=' && !isSpace(attributes[index])) ++index;
+        std::string_view key = attributes.substr(keyStart, index - keyStart);
+
+        while (index < attributes.size() && (isSpace(attributes[index]) || attributes[index] == '=')) ++index;
+        if (index >= attributes.size()) break;
+
+        char quote = attributes[index];
+        if (quote != '"' && quote != '\'') break;
+        std::size_t valueStart = ++index;
+        std::size_t valueEnd = attributes.find(quote, valueStart);
+        if (valueEnd == std::string_view::npos) break;
+        index = valueEnd + 1;
+
+        if (key == attribute) {
+            raw = attributes.substr(valueStart, valueEnd - valueStart);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool XmlStreamReader::getAttribute(std::string_view attribute, std::string& value) const {
+    std::string_view raw;
+    if (!findAttribute(attribute, raw)) return false;
+    decode(raw, value);
+    return true;
+}
+
+bool XmlStreamReader::getAttribute(std::string_view attribute, int& value) const {
+    if (!getAttribute(attribute, scratch)) return false;
+    char* parsedEnd = nullptr;
+    long parsed = std::strtol(scratch.c_str(), &parsedEnd, 10);
+    if (parsedEnd == scratch.c_str()) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool XmlStreamReader::getAttribute(std::string_view attribute, float& value) const {
+    if (!getAttribute(attribute, scratch)) return false;
+    char* parsedEnd = nullptr;
+    float parsed = std::strtof(scratch.c_str(), &parsedEnd);
+    if (parsedEnd == scratch.c_str()) return false;
+    value = parsed;
+    return true;
+}
+
+void XmlStreamReader::decode(std::string_view raw, std::string& out) {
+    out.clear();
+    std::size_t index = 0;
+    while (index < raw.size()) {
+        std::size_t ampersand = raw.find('&', index);
+        if (ampersand == std::string_view::npos) {
+            out.append(raw.data() + index, raw.size() - index);
+            break;
+        }
+        out.append(raw.data() + index, ampersand - index);
+
+        std::size_t semicolon = raw.find(';', ampersand);
+        if (semicolon == std::string_view::npos) {
+            out.append(raw.data() + ampersand, raw.size() - ampersand);
+            break;
+        }
+
+        std::string_view entity = raw.substr(ampersand + 1, semicolon - ampersand - 1);
+        if (entity == "amp") out.push_back('&');
+        else if (entity == "lt") out.push_back('<');
+        else if (entity == "gt") out.push_back('>');
+        else if (entity == "quot") out.push_back('"');
+        else if (entity == "apos") out.push_back('\'');
+        else if (entity.size() > 1 && entity[0] == '#') {
+            std::string digits(entity.substr(entity[1] == 'x' ? 2 : 1));
+            appendUtf8(out, std::strtoul(digits.c_str(), nullptr, entity[1] == 'x' ? 16 : 10));
+        } else {
+            // Entidade desconhecida: mantém como está, como o tinyxml2
+            out.append(raw.data() + ampersand, semicolon - ampersand + 1);
+        }
+        index = semicolon + 1;
+    }
+}
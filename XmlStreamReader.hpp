@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Leitor de XML em fluxo (pull) sobre um bloco de memória, p.ex. um MappedFile.
+// Não monta DOM: cada next() avança até o próximo elemento, fim de elemento ou
+// texto. Nomes e atributos são string_views para o próprio buffer; só textos e
+// valores com entidades (&amp; etc.) são decodificados, em buffers reutilizados.
+// Cobre o XML que o Ethanon e o tinyxml2 produzem (sem DTD nem namespaces).
+class XmlStreamReader {
+public:
+    enum class Event { StartElement, EndElement, Text, EndOfDocument, Error };
+
+    XmlStreamReader(const char* data, std::size_t size);
+
+    Event next();
+
+    // Válidos após StartElement / EndElement
+    std::string_view getName() const { return name; }
+    bool isEmptyElement() const { return emptyElement; }  // <x/>: o EndElement vem em seguida
+    // Valor decodificado do atributo; false se o elemento atual não o tiver
+    bool getAttribute(std::string_view attribute, std::string& value) const;
+    bool getAttribute(std::string_view attribute, int& value) const;
+    bool getAttribute(std::string_view attribute, float& value) const;
+
+    // Válido após Text (decodificado e sem espaços nas pontas)
+    const std::string& getText() const { return text; }
+
+    std::size_t getOffset() const { return static_cast<std::size_t>(position - begin); }
+    const std::string& getError() const { return error; }
+
+private:
+    bool findAttribute(std::string_view attribute, std::string_view& raw) const;
+    static void decode(std::string_view raw, std::string& out);
+    Event fail(const char* message);
+    bool skipPast(std::string_view terminator);
+
+    const char* begin;
+    const char* position;
+    const char* end;
+
+    std::string_view name;
+    std::string_view attributes;  // Trecho cru entre o nome e o fim da tag
+    bool emptyElement = false;
+    bool pendingEnd = false;      // EndElement implícito de <x/>
+    std::string text;
+    mutable std::string scratch;
+    std::string error;
+};
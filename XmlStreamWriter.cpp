@@ -0,0 +1,177 @@
+#include "XmlStreamWriter.hpp"
+#include <charconv>
+
+XmlStreamWriter::XmlStreamWriter() {
+    buffer.reserve(FlushThreshold + 4096);
+    stack.reserve(16);
+}
+
+XmlStreamWriter::~XmlStreamWriter() {
+    if (file.is_open()) {
+        close();
+    }
+}
+
+bool XmlStreamWriter::open(const std::string& filename) {
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    buffer.clear();
+    stack.clear();
+    depth = 0;
+    textDepth = -1;
+    elementJustOpened = false;
+    firstElement = true;
+    failed = !file.is_open();
+    return !failed;
+}
+
+void XmlStreamWriter::reset(int startDepth) {
+    if (file.is_open()) {
+        file.close();
+    }
+    buffer.clear();
+    stack.clear();
+    depth = startDepth;
+    textDepth = -1;
+    elementJustOpened = false;
+    firstElement = startDepth == 0;
+    failed = false;
+}
+
+std::string XmlStreamWriter::takeBuffer() {
+    std::string result;
+    result.swap(buffer);
+    return result;
+}
+
+void XmlStreamWriter::pushExternalChildren() {
+    sealElementIfJustOpened();
+    firstElement = false;
+}
+
+bool XmlStreamWriter::close() {
+    if (file.is_open()) {
+        file.write(buffer.data(), buffer.size());
+        buffer.clear();
+        file.close();
+        if (file.fail()) {
+            failed = true;
+        }
+    }
+    return !failed;
+}
+
+void XmlStreamWriter::flushIfFull() {
+    if (file.is_open() && buffer.size() >= FlushThreshold) {
+        if (!file.write(buffer.data(), buffer.size())) {
+            failed = true;
+        }
+        buffer.clear();
+    }
+}
+
+void XmlStreamWriter::printSpace(int count) {
+    for (int i = 0; i < count; ++i) {
+        write("    ");
+    }
+}
+
+void XmlStreamWriter::sealElementIfJustOpened() {
+    if (!elementJustOpened) return;
+    elementJustOpened = false;
+    buffer.push_back('>');
+}
+
+void XmlStreamWriter::prepareForNewNode() {
+    sealElementIfJustOpened();
+    if (firstElement) {
+        printSpace(depth);
+    } else if (textDepth < 0) {
+        buffer.push_back('\n');
+        printSpace(depth);
+    }
+    firstElement = false;
+}
+
+void XmlStreamWriter::writeEscaped(std::string_view text, bool attribute) {
+    // Mesmas entidades do tinyxml2: aspas e apóstrofo só em atributos
+    for (char c : text) {
+        switch (c) {
+            case '&': write("&amp;"); break;
+            case '<': write("&lt;"); break;
+            case '>': write("&gt;"); break;
+            case '"':
+                if (attribute) write("&quot;"); else buffer.push_back(c);
+                break;
+            case '\'':
+                if (attribute) write("&apos;"); else buffer.push_back(c);
+                break;
+            default:
+                buffer.push_back(c);
+                break;
+        }
+    }
+}
+
+void XmlStreamWriter::pushDeclaration(std::string_view value) {
+    prepareForNewNode();
+    write("<?");
+    write(value);
+    write("?>");
+}
+
+void XmlStreamWriter::openElement(const char* name) {
+    prepareForNewNode();
+    stack.push_back(name);
+    buffer.push_back('<');
+    write(name);
+    elementJustOpened = true;
+    ++depth;
+}
+
+void XmlStreamWriter::pushAttribute(const char* name, int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    pushAttribute(name, std::string_view(digits, result.ptr - digits));
+}
+
+void XmlStreamWriter::pushAttribute(const char* name, std::string_view value) {
+    buffer.push_back(' ');
+    write(name);
+    write("=\"");
+    writeEscaped(value, true);
+    buffer.push_back('"');
+}
+
+void XmlStreamWriter::pushText(std::string_view text) {
+    textDepth = depth - 1;
+    sealElementIfJustOpened();
+    writeEscaped(text, false);
+}
+
+void XmlStreamWriter::closeElement() {
+    --depth;
+    const char* name = stack.back();
+    stack.pop_back();
+
+    if (elementJustOpened) {
+        write("/>");
+    } else {
+        if (textDepth < 0) {
+            buffer.push_back('\n');
+            printSpace(depth);
+        }
+        write("</");
+        write(name);
+        buffer.push_back('>');
+    }
+
+    if (textDepth == depth) {
+        textDepth = -1;
+    }
+    if (depth == 0) {
+        buffer.push_back('\n');
+    }
+    elementJustOpened = false;
+
+    flushIfFull();
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Escritor de XML em uma única passada, sem DOM.
+// Reproduz byte a byte a formatação do tinyxml2::XMLPrinter (indentação de 4
+// espaços, elementos vazios como <x/>, texto na mesma linha da tag) para que os
+// arquivos gerados sejam idênticos aos do antigo XMLDocument::SaveFile.
+// A saída vai para um buffer reutilizado, descarregado no arquivo em blocos
+// (open) ou mantido só em memória (reset), p.ex. para gerar trechos em paralelo.
+class XmlStreamWriter {
+public:
+    static constexpr std::size_t FlushThreshold = 256 * 1024;
+
+    XmlStreamWriter();
+    ~XmlStreamWriter();
+
+    bool open(const std::string& filename);
+    bool close();  // Descarrega o buffer; false se alguma escrita falhou
+
+    // Escrita só em memória. Com startDepth > 0 gera um trecho que será inserido
+    // dentro de um elemento já aberto nessa profundidade
+    void reset(int startDepth = 0);
+    const std::string& getBuffer() const { return buffer; }
+    std::string takeBuffer();
+    // Os filhos do elemento aberto foram escritos à parte (trechos de reset)
+    void pushExternalChildren();
+
+    void pushDeclaration(std::string_view value);
+    void openElement(const char* name);
+    void pushAttribute(const char* name, int value);
+    void pushAttribute(const char* name, std::string_view value);
+    void pushText(std::string_view text);
+    void closeElement();
+
+private:
+    void prepareForNewNode();
+    void sealElementIfJustOpened();
+    void printSpace(int count);
+    void write(std::string_view text) { buffer.append(text.data(), text.size()); }
+    void writeEscaped(std::string_view text, bool attribute);
+    void flushIfFull();
+
+    std::ofstream file;
+    std::string buffer;
+    std::vector<const char*> stack;  // Nomes são literais; nada é copiado por elemento
+    int depth = 0;
+    int textDepth = -1;
+    bool elementJustOpened = false;
+    bool firstElement = true;
+    bool failed = false;
+};
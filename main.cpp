@@ -1,7 +1,15 @@
 #include "Editor.hpp"
+#include "BatchTool.hpp"
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    // Sem janela: conversão e validação em lote (ver BatchTool)
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        return BatchTool::run(std::vector<std::string>(argv + 2, argv + argc));
+    }
 
-int main() {
     Editor editor;
     editor.run();
     return 0;
-}
\ No newline at end of file
+}